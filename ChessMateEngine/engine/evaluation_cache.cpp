@@ -0,0 +1,87 @@
+#include "evaluation_cache.h"
+
+#include <fly/types/numeric/literals.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+using namespace fly::literals::numeric_literals;
+
+namespace chessmate {
+
+namespace {
+
+    // Number of bytes in a megabyte
+    const std::size_t s_megabyte = 1 << 20;
+
+    // Odd multiplier which spreads the evaluation state's flags across a key,
+    // while keeping distinct flags distinct
+    const hash_type s_stateMultiplier = 0x9e3779b97f4a7c15_u64;
+
+} // namespace
+
+//==================================================================================================
+EvaluationCache::EvaluationCache(std::size_t megabytes)
+{
+    std::size_t count = std::max<std::size_t>(megabytes * s_megabyte / sizeof(Slot), 1);
+    count = std::bit_floor(count);
+
+    m_slots = std::vector<Slot>(count);
+    m_slotMask = count - 1;
+}
+
+//==================================================================================================
+hash_type EvaluationCache::GetKey(const BitBoard &board)
+{
+    // Castling rights only cover the king and rook moved flags while castling
+    // is still possible, and the rest are not covered at all
+    const std::array<bool, 11> flags = {
+        board.HasWhiteMovedKing(),
+        board.HasWhiteMovedQueen(),
+        board.HasWhiteMovedKingsideRook(),
+        board.HasWhiteMovedQueensideRook(),
+        board.HasBlackMovedKing(),
+        board.HasBlackMovedQueen(),
+        board.HasBlackMovedKingsideRook(),
+        board.HasBlackMovedQueensideRook(),
+        board.HasWhiteCastled(),
+        board.HasBlackCastled(),
+        board.IsEndGame(),
+    };
+
+    hash_type state = 0;
+
+    for (std::size_t i = 0; i < flags.size(); ++i)
+    {
+        state |= static_cast<hash_type>(flags[i]) << i;
+    }
+
+    return board.GetHashKey() ^ (state * s_stateMultiplier);
+}
+
+//==================================================================================================
+bool EvaluationCache::Probe(const hash_type &key, int &score) const
+{
+    const Slot &slot = m_slots[key & m_slotMask];
+
+    if (slot.m_valid && (slot.m_key == key))
+    {
+        score = slot.m_score;
+        return true;
+    }
+
+    return false;
+}
+
+//==================================================================================================
+void EvaluationCache::Store(const hash_type &key, const int &score)
+{
+    Slot &slot = m_slots[key & m_slotMask];
+
+    slot.m_key = key;
+    slot.m_score = score;
+    slot.m_valid = true;
+}
+
+} // namespace chessmate
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "game/bit_board.h"
+#include "game/board_types.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace chessmate {
+
+/**
+ * Class to cache the static scores of positions, keyed by the positions'
+ * Zobrist hash keys. The same positions are scored again and again during a
+ * search, both through transpositions and across iterative deepening passes.
+ *
+ * The evaluator also reads state which the Zobrist hash key does not cover,
+ * such as which pieces have moved, so that state is mixed into each key.
+ *
+ * The cache is lossy: each key maps to a single entry, which is always replaced
+ * by the most recent score stored there. The cache is not thread-safe; each
+ * search thread owns its own.
+ *
+ * @author Timothy Flynn (trflynn89@gmail.com)
+ * @version October 17, 2026
+ */
+class EvaluationCache
+{
+public:
+    /**
+     * Constructor. Creates an empty cache.
+     *
+     * @param size_t The size of the cache, in megabytes.
+     */
+    explicit EvaluationCache(std::size_t);
+
+    /**
+     * Get the key to cache a position's score under: its hash key, mixed with
+     * the state the evaluator reads which the hash key does not cover.
+     *
+     * @param BitBoard The position to get the key of.
+     *
+     * @return The position's key.
+     */
+    static hash_type GetKey(const BitBoard &);
+
+    /**
+     * Look up a position's score in the cache.
+     *
+     * @param hash_type The position's hash key.
+     * @param int The score to fill if the position is found.
+     *
+     * @return True if the position was found.
+     */
+    bool Probe(const hash_type &, int &) const;
+
+    /**
+     * Store a position's score in the cache.
+     *
+     * @param hash_type The position's hash key.
+     * @param int The score to store.
+     */
+    void Store(const hash_type &, const int &);
+
+private:
+    /**
+     * A single entry, as stored in the cache.
+     */
+    struct Slot
+    {
+        hash_type m_key;
+        int m_score;
+        bool m_valid;
+    };
+
+    std::vector<Slot> m_slots;
+    hash_type m_slotMask;
+};
+
+} // namespace chessmate
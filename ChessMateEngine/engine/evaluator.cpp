@@ -1,5 +1,13 @@
 #include "evaluator.h"
 
+#include "game/attacks.h"
+
+#include <fly/types/numeric/literals.hpp>
+
+#include <bit>
+
+using namespace fly::literals::numeric_literals;
+
 namespace chessmate {
 
 namespace {
@@ -12,14 +20,28 @@ namespace {
     const value_type s_queenValue = 975;
     const value_type s_kingValue = 32767;
 
-    // Array to store the "meaning" of a pawn in a file
-    // i.e. account for isolated and doubled pawns
-    value_type s_whitePawnFileValue[] = {0, 0, 0, 0, 0, 0, 0, 0};
-    value_type s_blackPawnFileValue[] = {0, 0, 0, 0, 0, 0, 0, 0};
+    // Penalty for each pawn beyond the first on a file, and for each file of
+    // pawns with no friendly pawns on either adjacent file
+    const value_type s_doubledPawnPenalty = 16;
+    const value_type s_isolatedPawnPenalty = 15;
 
-    // Count the number of bishops
-    value_type s_whiteBishopCount = 0;
-    value_type s_blackBishopCount = 0;
+    // Bonus for a passed pawn, indexed by its rank counted from its own side
+    const std::array<value_type, NUM_RANKS> s_passedPawnBonus = {0, 10, 15, 25, 40, 65, 100, 0};
+
+    // Weights of the pieces attacking or defending a piece - better to attack
+    // with pawn than queen
+    const value_type s_pawnAttackWeight = 6;
+    const value_type s_knightAttackWeight = 3;
+    const value_type s_bishopAttackWeight = 3;
+    const value_type s_rookAttackWeight = 2;
+    const value_type s_queenAttackWeight = 1;
+
+    // Squares a pawn may attack from; a pawn on the last rank has no moves
+    const board_type s_pawnSquares = 0x00ffffffffffff00_u64;
+
+    // Squares on the A and H files
+    const board_type s_fileA = 0x0101010101010101_u64;
+    const board_type s_fileH = 0x8080808080808080_u64;
 
     // Tables go from 0th index = A1, to 63rd index = H8
 
@@ -52,450 +74,528 @@ namespace {
         -30, -10, 30,  40,  40,  30,  -10, -30, -30, -10, 20,  30,  30,  20,  -10, -30,
         -30, -20, -10, 0,   0,   -10, -20, -30, -50, -40, -30, -20, -20, -30, -40, -50};
 
+    /**
+     * Build the masks of every square on each file.
+     */
+    std::array<board_type, NUM_FILES> makeFileMasks()
+    {
+        std::array<board_type, NUM_FILES> masks;
+
+        for (square_type file = FILE_A; file <= FILE_H; ++file)
+        {
+            masks[file] = s_fileA << file;
+        }
+
+        return masks;
+    }
+
+    /**
+     * Build the masks of every square on the files adjacent to each file.
+     */
+    std::array<board_type, NUM_FILES> makeAdjacentFileMasks()
+    {
+        std::array<board_type, NUM_FILES> masks;
+
+        for (square_type file = FILE_A; file <= FILE_H; ++file)
+        {
+            const board_type mask = s_fileA << file;
+            masks[file] = ((mask << 1) & ~s_fileA) | ((mask >> 1) & ~s_fileH);
+        }
+
+        return masks;
+    }
+
+    const std::array<board_type, NUM_FILES> s_fileMasks = makeFileMasks();
+    const std::array<board_type, NUM_FILES> s_adjacentFileMasks = makeAdjacentFileMasks();
+
+    /**
+     * Build the masks of the squares an enemy pawn could stop a pawn of each
+     * color on each square from: those ahead of the pawn on its own file and
+     * on the adjacent files.
+     */
+    std::array<std::array<board_type, BOARD_SIZE>, NONE> makePassedPawnMasks()
+    {
+        std::array<std::array<board_type, BOARD_SIZE>, NONE> masks;
+
+        for (square_type square = 0; square < BOARD_SIZE; ++square)
+        {
+            const square_type rank = GET_RANK(square);
+            const board_type files =
+                s_fileMasks[GET_FILE(square)] | s_adjacentFileMasks[GET_FILE(square)];
+
+            const board_type above = (rank == RANK_8) ? 0 : (~0_u64 << (8 * (rank + 1)));
+            const board_type below = (1_u64 << (8 * rank)) - 1;
+
+            masks[WHITE][square] = files & above;
+            masks[BLACK][square] = files & below;
+        }
+
+        return masks;
+    }
+
+    const std::array<std::array<board_type, BOARD_SIZE>, NONE> s_passedPawnMasks =
+        makePassedPawnMasks();
+
+    /**
+     * Get the squares attacked by a set of pawns of one color.
+     */
+    board_type pawnAttacks(const board_type &pawns, const color_type &color)
+    {
+        if (color == WHITE)
+        {
+            return ((pawns << 7) & ~s_fileH) | ((pawns << 9) & ~s_fileA);
+        }
+
+        return ((pawns >> 7) & ~s_fileA) | ((pawns >> 9) & ~s_fileH);
+    }
+
 } // namespace
 
+//==================================================================================================
+Evaluator::EvaluationContext::EvaluationContext(
+    const BitBoard &board,
+    const PawnHashTable::Entry &pawns) :
+    m_board(board),
+    m_occupied(board.GetColorPieces(WHITE) | board.GetColorPieces(BLACK))
+{
+    for (color_type color = WHITE; color < NONE; ++color)
+    {
+        const color_type enemy = !color;
+
+        // Pieces are not counted as mobile onto their own pieces, or onto
+        // squares where an enemy pawn could take them. Kings also avoid every
+        // square the enemy attacks.
+        m_safeSquares[color] = ~board.GetColorPieces(color) & ~pawns.m_attacks[enemy];
+        m_kingSafeSquares[color] = ~board.GetColorPieces(color) & ~board.GetAttackedSquares(enemy);
+    }
+}
+
 //==================================================================================================
 Evaluator::Evaluator(const color_type &engineColor) : m_engineColor(engineColor)
 {
 }
 
 //==================================================================================================
-int Evaluator::Score(const std::shared_ptr<BitBoard> &spBoard, const ValidMoveSet &vms) const
+int Evaluator::Score(BitBoard &board, bool hasLegalMoves, PawnHashTable &pawnHashTable) const
 {
-    value_type remainingPieces = 0;
     int score = 0;
 
-    // Reinitialize values
-    for (square_type i = FILE_A; i <= FILE_H; ++i)
-    {
-        s_whitePawnFileValue[i] = 0;
-        s_blackPawnFileValue[i] = 0;
-    }
-
-    s_whiteBishopCount = 0;
-    s_blackBishopCount = 0;
-
     // Check for game over
-    if (vms.GetMyValidMoves().empty())
+    if (!hasLegalMoves)
     {
-        if (spBoard->IsWhiteInCheck())
+        if (board.IsWhiteInCheck())
         {
             return (m_engineColor == WHITE ? -s_kingValue : s_kingValue);
         }
-        else if (spBoard->IsBlackInCheck())
+        else if (board.IsBlackInCheck())
         {
             return (m_engineColor == BLACK ? -s_kingValue : s_kingValue);
         }
 
         return 0;
     }
-    else if (spBoard->IsStalemateViaFiftyMoves())
+    else if (board.IsStalemateViaFiftyMoves())
     {
         return 0;
     }
-    else if (spBoard->IsStalemateViaRepetition())
+    else if (board.IsStalemateViaRepetition())
     {
         return 0;
     }
 
     // Check for checks
-    if (spBoard->IsWhiteInCheck())
+    if (board.IsWhiteInCheck())
     {
-        score -= (spBoard->IsEndGame() ? 95 : 75);
+        score -= (board.IsEndGame() ? 95 : 75);
     }
-    else if (spBoard->IsBlackInCheck())
+    else if (board.IsBlackInCheck())
     {
-        score += (spBoard->IsEndGame() ? 95 : 75);
+        score += (board.IsEndGame() ? 95 : 75);
     }
 
     // Add for tempo
-    score += ((spBoard->GetPlayerInTurn() == WHITE) ? 10 : -10);
+    score += ((board.GetPlayerInTurn() == WHITE) ? 10 : -10);
 
     // Try to prevent opponent from castling
-    if (spBoard->HasWhiteCastled())
+    if (board.HasWhiteCastled())
     {
         score += 40;
     }
-    if (spBoard->HasBlackCastled())
+    if (board.HasBlackCastled())
     {
         score -= 40;
     }
 
-    // Loop through all pieces
-    for (square_type s = 0; s < BOARD_SIZE; ++s)
-    {
-        square_type rank = GET_RANK(s);
-        square_type file = GET_FILE(s);
-
-        if (!spBoard->IsEmpty(rank, file))
-        {
-            int pieceScore = evaluateSinglePiece(spBoard, vms, rank, file);
+    // Look up the pawn structure, only evaluating it if it is not cached
+    const hash_type pawnHashKey = board.GetPawnHashKey();
+    PawnHashTable::Entry pawns;
 
-            score += (spBoard->IsWhite(rank, file) ? pieceScore : -pieceScore);
-            ++remainingPieces;
-        }
+    if (!pawnHashTable.Probe(pawnHashKey, pawns))
+    {
+        pawns = evaluatePawns(board);
+        pawnHashTable.Store(pawnHashKey, pawns);
     }
 
-    // Check for end game phase
-    if (remainingPieces < 10)
+    // Evaluate every piece, and then the pawn structure
+    const EvaluationContext context(board, pawns);
+
+    for (piece_type piece = PAWN; piece <= KING; ++piece)
     {
-        spBoard->SetEndGame(true);
+        score += evaluatePieces(context, piece, WHITE);
+        score -= evaluatePieces(context, piece, BLACK);
     }
 
-    // Check for white isolated pawns
-    for (square_type i = FILE_A; i <= FILE_H; ++i)
+    score += pawns.m_score;
+
+    UpdateGamePhase(board);
+    return ((m_engineColor == WHITE) ? score : -score);
+}
+
+//==================================================================================================
+value_type Evaluator::GetPieceValue(const piece_type &piece)
+{
+    switch (piece)
     {
-        if (s_whitePawnFileValue[i] > 0)
-        {
-            if (((i > FILE_A) && (s_whitePawnFileValue[i - 1] == 0)) ||
-                ((i < FILE_H) && (s_whitePawnFileValue[i + 1] == 0)))
-            {
-                score -= 15;
-            }
-        }
+        case PAWN:
+            return s_pawnValue;
+        case KNIGHT:
+            return s_knightValue;
+        case BISHOP:
+            return s_bishopValue;
+        case ROOK:
+            return s_rookValue;
+        case QUEEN:
+            return s_queenValue;
+        default:
+            return s_kingValue;
     }
+}
+
+//==================================================================================================
+void Evaluator::UpdateGamePhase(BitBoard &board)
+{
+    const board_type occupied = board.GetColorPieces(WHITE) | board.GetColorPieces(BLACK);
 
-    // Check for black isolated pawns
-    for (square_type i = FILE_A; i <= FILE_H; ++i)
+    if (std::popcount(occupied) < 10)
     {
-        if (s_blackPawnFileValue[i] > 0)
-        {
-            if (((i > FILE_A) && (s_blackPawnFileValue[i - 1] == 0)) ||
-                ((i < FILE_H) && (s_blackPawnFileValue[i + 1] == 0)))
-            {
-                score += 15;
-            }
-        }
+        board.SetEndGame(true);
     }
+}
 
-    // Check for white passed pawns
-    for (square_type i = FILE_A; i <= FILE_H; ++i)
+//==================================================================================================
+int Evaluator::evaluatePieces(
+    const EvaluationContext &context,
+    const piece_type &piece,
+    const color_type &color) const
+{
+    const BitBoard &board = context.m_board;
+    const board_type pieces = board.GetPieces(piece) & board.GetColorPieces(color);
+    int score = 0;
+
+    for (board_type remaining = pieces; remaining != 0; remaining &= remaining - 1)
     {
-        if ((s_whitePawnFileValue[i] > 0) && (s_blackPawnFileValue[i] == 0))
-        {
-            score += s_whitePawnFileValue[i];
-        }
+        const auto square = static_cast<square_type>(std::countr_zero(remaining));
+        score += evaluateSinglePiece(context, piece, color, square);
     }
 
-    // Check for black passed pawns
-    for (square_type i = FILE_A; i <= FILE_H; ++i)
+    // Bishops are better if we have more than one
+    if ((piece == BISHOP) && (pieces != 0))
     {
-        if ((s_blackPawnFileValue[i] > 0) && (s_whitePawnFileValue[i] == 0))
-        {
-            score += s_blackPawnFileValue[i];
-        }
+        score += (std::popcount(pieces) - 1) * 10;
     }
 
-    return ((m_engineColor == WHITE) ? score : -score);
+    return score;
 }
 
 //==================================================================================================
-int Evaluator::evaluateSinglePiece(
-    const std::shared_ptr<BitBoard> &spBoard,
-    const ValidMoveSet &vms,
-    const square_type &rank,
-    const square_type &file) const
+PawnHashTable::Entry Evaluator::evaluatePawns(const BitBoard &board) const
 {
-    MoveList myMoveSet = vms.GetMyValidMoves();
-    MoveList oppMoveSet = vms.GetOppValidMoves();
+    PawnHashTable::Entry entry;
+    entry.m_score = evaluatePawnStructure(board, WHITE) - evaluatePawnStructure(board, BLACK);
 
-    square_type loc = GET_SQUARE(rank, file);
-    color_type pieceColor = spBoard->GetOccupant(rank, file);
-    int score = 0;
-
-    if (pieceColor == BLACK)
+    for (color_type color = WHITE; color < NONE; ++color)
     {
-        loc = BOARD_SIZE - loc - 1;
+        const board_type pawns = board.GetPieces(PAWN) & board.GetColorPieces(color);
+        entry.m_attacks[color] = pawnAttacks(pawns, color);
     }
 
-    // Account for the attacked/defended value of the piece
-    bool useMyMoves = (pieceColor == spBoard->GetPlayerInTurn());
+    return entry;
+}
 
-    value_type defendedValue = 0;
-    value_type attackedValue = 0;
+//==================================================================================================
+int Evaluator::evaluatePawnStructure(const BitBoard &board, const color_type &color) const
+{
+    const board_type pawns = board.GetPieces(PAWN) & board.GetColorPieces(color);
+    const board_type enemyPawns = board.GetPieces(PAWN) & board.GetColorPieces(!color);
+    int score = 0;
 
-    // Get correct attack/defense values
-    if (useMyMoves)
+    for (square_type file = FILE_A; file <= FILE_H; ++file)
     {
-        defendedValue = vms.GetDefendValue(rank, file);
-        attackedValue = vms.GetAttackValue(rank, file);
-    }
-    else
-    {
-        defendedValue = vms.GetAttackValue(rank, file);
-        attackedValue = vms.GetDefendValue(rank, file);
-    }
+        const int count = std::popcount(pawns & s_fileMasks[file]);
 
-    score += defendedValue;
-    score -= attackedValue;
+        if (count == 0)
+        {
+            continue;
+        }
 
-    // Penalize further for situations where we will lose the piece
-    if (defendedValue < attackedValue)
-    {
-        score -= (attackedValue - defendedValue) * 10;
-    }
+        score -= (count - 1) * s_doubledPawnPenalty;
 
-    // Add points for mobility
-    MoveList &moveSet = (useMyMoves ? myMoveSet : oppMoveSet);
+        if ((pawns & s_adjacentFileMasks[file]) == 0)
+        {
+            score -= s_isolatedPawnPenalty;
+        }
+    }
 
-    for (auto it = moveSet.begin(); it != moveSet.end(); ++it)
+    for (board_type remaining = pawns; remaining != 0; remaining &= remaining - 1)
     {
-        if ((it->GetStartRank() == rank) && (it->GetStartFile() == file))
+        const auto square = static_cast<square_type>(std::countr_zero(remaining));
+
+        if ((enemyPawns & s_passedPawnMasks[color][square]) == 0)
         {
-            ++score;
+            const square_type rank = GET_RANK(square);
+            score += s_passedPawnBonus[(color == WHITE) ? rank : (RANK_8 - rank)];
         }
     }
 
-    // Evaluate depending on piece
+    return score;
+}
 
-    // Pawn
-    if (spBoard->IsPawn(rank, file))
-    {
-        score += s_pawnValue;
-        score += s_pawnTable[loc];
+//==================================================================================================
+int Evaluator::evaluateMobility(
+    const EvaluationContext &context,
+    const piece_type &piece,
+    const color_type &color,
+    const square_type &square) const
+{
+    const board_type occupied = context.m_occupied;
+    const board_type safe = context.m_safeSquares[color];
+    board_type moves = 0;
 
-        // Rook-file pawns worth less - can only attack in one direction
-        if (file == FILE_A || file == FILE_H)
+    switch (piece)
+    {
+        case PAWN:
         {
-            score -= 15;
+            // A pawn may push to an empty square ahead, or capture
+            const board_type pawn = 1_u64 << square;
+            const board_type push = ((color == WHITE) ? (pawn << 8) : (pawn >> 8)) & ~occupied;
+            const board_type enemies = context.m_board.GetColorPieces(!color);
+
+            moves = push | (Attacks::GetPawnAttacks(square, color) & enemies);
+            break;
         }
 
-        // White pawn
-        if (pieceColor == WHITE)
-        {
-            // If the value isn't 0, we have a doubled pawn
-            if (s_whitePawnFileValue[file] > 0)
-            {
-                score -= 16;
-            }
+        case KNIGHT:
+            moves = Attacks::GetKnightAttacks(square) & safe;
+            break;
 
-            // Good to advance pawn to second rank
-            if (rank == RANK_2)
-            {
-                if (attackedValue == 0)
-                {
-                    s_whitePawnFileValue[file] += 200;
+        case BISHOP:
+            moves = Attacks::GetBishopAttacks(square, occupied) & safe;
+            break;
 
-                    if (defendedValue > 0)
-                    {
-                        s_whitePawnFileValue[file] += 50;
-                    }
-                }
-            }
-            // Good to advance to third rank
-            else if (rank == RANK_3)
-            {
-                if (attackedValue == 0)
-                {
-                    s_whitePawnFileValue[file] += 100;
+        case ROOK:
+            moves = Attacks::GetRookAttacks(square, occupied) & safe;
+            break;
 
-                    if (defendedValue > 0)
-                    {
-                        s_whitePawnFileValue[file] += 25;
-                    }
-                }
-            }
+        case QUEEN:
+            moves = Attacks::GetQueenAttacks(square, occupied) & safe;
+            break;
 
-            // Mark that there is a pawn in this file
-            s_whitePawnFileValue[file] += 10;
-        }
+        case KING:
+            moves = Attacks::GetKingAttacks(square) & context.m_kingSafeSquares[color];
+            break;
+    }
 
-        // Black pawn
-        else if (pieceColor == BLACK)
-        {
-            // If the value isn't 0, we have a doubled pawn
-            if (s_blackPawnFileValue[file] > 0)
-            {
-                score -= 16;
-            }
+    return std::popcount(moves);
+}
 
-            // Good to advance pawn to seventh rank
-            if (rank == RANK_7)
-            {
-                if (attackedValue == 0)
-                {
-                    s_blackPawnFileValue[file] += 200;
+//==================================================================================================
+value_type Evaluator::evaluateDefenders(
+    const EvaluationContext &context,
+    const color_type &color,
+    const square_type &square) const
+{
+    const BitBoard &board = context.m_board;
+    const board_type occupied = context.m_occupied;
+    const board_type mine = board.GetColorPieces(color);
+
+    // A pawn defends the squares a pawn of the other color on them would
+    // attack. Sliders are blocked by the first piece in their way.
+    const board_type pawns =
+        Attacks::GetPawnAttacks(square, !color) & board.GetPieces(PAWN) & s_pawnSquares;
+    const board_type bishops = Attacks::GetBishopAttacks(square, occupied) & board.GetPieces(BISHOP);
+    const board_type rooks = Attacks::GetRookAttacks(square, occupied) & board.GetPieces(ROOK);
+    const board_type queens = Attacks::GetQueenAttacks(square, occupied) & board.GetPieces(QUEEN);
+
+    return static_cast<value_type>(
+        (std::popcount(pawns & mine) * s_pawnAttackWeight) +
+        (std::popcount(bishops & mine) * s_bishopAttackWeight) +
+        (std::popcount(rooks & mine) * s_rookAttackWeight) +
+        (std::popcount(queens & mine) * s_queenAttackWeight));
+}
 
-                    if (defendedValue > 0)
-                    {
-                        s_blackPawnFileValue[file] += 50;
-                    }
-                }
-            }
-            // Good to advance to sixth rank
-            else if (rank == RANK_6)
-            {
-                if (attackedValue == 0)
-                {
-                    s_blackPawnFileValue[file] += 100;
+//==================================================================================================
+value_type Evaluator::evaluateAttackers(
+    const EvaluationContext &context,
+    const color_type &color,
+    const square_type &square) const
+{
+    const BitBoard &board = context.m_board;
+    const board_type theirs = board.GetColorPieces(color);
 
-                    if (defendedValue > 0)
-                    {
-                        s_blackPawnFileValue[file] += 25;
-                    }
-                }
-            }
+    const board_type pawns =
+        Attacks::GetPawnAttacks(square, !color) & board.GetPieces(PAWN) & s_pawnSquares;
+    const board_type knights = Attacks::GetKnightAttacks(square) & board.GetPieces(KNIGHT);
 
-            // Mark that there is a pawn in this file
-            s_blackPawnFileValue[file] += 10;
-        }
-    }
+    return static_cast<value_type>(
+        (std::popcount(pawns & theirs) * s_pawnAttackWeight) +
+        (std::popcount(knights & theirs) * s_knightAttackWeight));
+}
 
-    // Knight
-    else if (spBoard->IsKnight(rank, file))
-    {
-        score += s_knightValue;
-        score += s_knightTable[loc];
+//==================================================================================================
+int Evaluator::evaluateSinglePiece(
+    const EvaluationContext &context,
+    const piece_type &piece,
+    const color_type &pieceColor,
+    const square_type &square) const
+{
+    const BitBoard &board = context.m_board;
 
-        // Knights are worth less in the end game phase
-        if (spBoard->IsEndGame())
-        {
-            score -= 10;
-        }
-    }
+    const square_type rank = GET_RANK(square);
+    const square_type file = GET_FILE(square);
 
-    // Bishop
-    else if (spBoard->IsBishop(rank, file))
-    {
-        score += s_bishopValue;
-        score += s_bishopTable[loc];
+    const square_type loc = ((pieceColor == BLACK) ? (BOARD_SIZE - square - 1) : square);
+    int score = 0;
 
-        // Bishops are worth more in the end game phase
-        if (spBoard->IsEndGame())
-        {
-            score += 10;
-        }
+    // Account for the attacked/defended value of the piece
+    const value_type defendedValue = evaluateDefenders(context, pieceColor, square);
+    const value_type attackedValue = evaluateAttackers(context, !pieceColor, square);
 
-        // Bishops are better if we have more than one
-        if (pieceColor == WHITE)
-        {
-            ++s_whiteBishopCount;
-            if (s_whiteBishopCount >= 2)
-            {
-                score += 10;
-            }
-        }
-        else if (pieceColor == BLACK)
-        {
-            ++s_blackBishopCount;
-            if (s_blackBishopCount >= 2)
-            {
-                score += 10;
-            }
-        }
+    score += defendedValue;
+    score -= attackedValue;
+
+    // Penalize further for situations where we will lose the piece
+    if (defendedValue < attackedValue)
+    {
+        score -= (attackedValue - defendedValue) * 10;
     }
 
-    // Rook
-    else if (spBoard->IsRook(rank, file))
+    // Add points for mobility
+    const int mobility = evaluateMobility(context, piece, pieceColor, square);
+    score += mobility;
+
+    // Evaluate depending on piece
+    switch (piece)
     {
-        score += s_rookValue;
+        case PAWN:
+            score += s_pawnValue;
+            score += s_pawnTable[loc];
 
-        // Encourage rooks not to move until we have castled
-        if (pieceColor == WHITE)
-        {
-            if (!spBoard->HasWhiteCastled())
+            // Rook-file pawns worth less - can only attack in one direction
+            if ((file == FILE_A) || (file == FILE_H))
             {
-                if (rank != RANK_1)
-                {
-                    score -= 10;
-                }
-                else if ((file != FILE_A) && (file != FILE_H))
-                {
-                    score -= 10;
-                }
+                score -= 15;
             }
-        }
-        else if (pieceColor == BLACK)
-        {
-            if (!spBoard->HasBlackCastled())
+
+            break;
+
+        case KNIGHT:
+            score += s_knightValue;
+            score += s_knightTable[loc];
+
+            // Knights are worth less in the end game phase
+            if (board.IsEndGame())
             {
-                if (rank != RANK_8)
-                {
-                    score -= 10;
-                }
-                else if ((file != FILE_A) && (file != FILE_H))
-                {
-                    score -= 10;
-                }
+                score -= 10;
             }
-        }
-    }
 
-    // Queen
-    else if (spBoard->IsQueen(rank, file))
-    {
-        score += s_queenValue;
+            break;
 
-        // Discourage queen from moving too early
-        if (pieceColor == WHITE)
-        {
-            if (spBoard->HasWhiteMovedQueen() && !spBoard->IsEndGame())
+        case BISHOP:
+            score += s_bishopValue;
+            score += s_bishopTable[loc];
+
+            // Bishops are worth more in the end game phase
+            if (board.IsEndGame())
             {
-                score -= 10;
+                score += 10;
             }
-        }
-        else if (pieceColor == BLACK)
+
+            break;
+
+        case ROOK:
         {
-            if (spBoard->HasBlackMovedQueen() && !spBoard->IsEndGame())
+            score += s_rookValue;
+
+            // Encourage rooks not to move until we have castled
+            const bool castled =
+                ((pieceColor == WHITE) ? board.HasWhiteCastled() : board.HasBlackCastled());
+            const square_type homeRank = ((pieceColor == WHITE) ? RANK_1 : RANK_8);
+
+            if (!castled && ((rank != homeRank) || ((file != FILE_A) && (file != FILE_H))))
             {
                 score -= 10;
             }
+
+            break;
         }
-    }
 
-    // King
-    else if (spBoard->IsKing(rank, file))
-    {
-        score += s_kingValue;
+        case QUEEN:
+        {
+            score += s_queenValue;
 
-        // Keep king mobile
-        value_type numberOfKingMoves = 0;
+            // Discourage queen from moving too early
+            const bool movedQueen =
+                ((pieceColor == WHITE) ? board.HasWhiteMovedQueen() : board.HasBlackMovedQueen());
 
-        for (auto it = myMoveSet.begin(); it != myMoveSet.end(); ++it)
-        {
-            if ((it->GetStartRank() == rank) && (it->GetStartFile() == file))
+            if (movedQueen && !board.IsEndGame())
             {
-                ++numberOfKingMoves;
+                score -= 10;
             }
-        }
 
-        if (numberOfKingMoves < 2)
-        {
-            score -= 5;
-        }
-
-        if (spBoard->IsEndGame())
-        {
-            score += s_kingTableEndGame[loc];
+            break;
         }
-        else
-        {
-            score += s_kingTable[loc];
 
-            // Encourage castling
-            bool castled = false;
+        case KING:
+            score += s_kingValue;
 
-            if (pieceColor == WHITE)
+            // Keep king mobile
+            if (mobility < 2)
             {
-                castled =
-                    spBoard->HasWhiteMovedKingsideRook() || spBoard->HasWhiteMovedQueensideRook();
+                score -= 5;
+            }
 
-                if (spBoard->HasWhiteMovedKing() && !castled)
-                {
-                    score -= 30;
-                }
+            if (board.IsEndGame())
+            {
+                score += s_kingTableEndGame[loc];
             }
-            else if (pieceColor == BLACK)
+            else
             {
-                castled =
-                    spBoard->HasBlackMovedKingsideRook() || spBoard->HasBlackMovedQueensideRook();
+                score += s_kingTable[loc];
 
-                if (spBoard->HasBlackMovedKing() && !castled)
+                // Encourage castling
+                if (pieceColor == WHITE)
                 {
-                    score -= 30;
+                    const bool castled =
+                        board.HasWhiteMovedKingsideRook() || board.HasWhiteMovedQueensideRook();
+
+                    if (board.HasWhiteMovedKing() && !castled)
+                    {
+                        score -= 30;
+                    }
+                }
+                else
+                {
+                    const bool castled =
+                        board.HasBlackMovedKingsideRook() || board.HasBlackMovedQueensideRook();
+
+                    if (board.HasBlackMovedKing() && !castled)
+                    {
+                        score -= 30;
+                    }
                 }
             }
-        }
+
+            break;
     }
 
     return score;
@@ -1,9 +1,11 @@
 #pragma once
 
+#include "engine/pawn_hash_table.h"
 #include "game/bit_board.h"
 #include "game/board_types.h"
 #include "movement/move.h"
-#include "movement/valid_move_set.h"
+
+#include <array>
 
 namespace chessmate {
 
@@ -13,6 +15,16 @@ namespace chessmate {
  * - The more negative the score is, the better the board is for the human.
  * - A score of 0 is a draw.
  *
+ * Pieces are evaluated by iterating over each piece type's bitboard, and pawn
+ * structure is evaluated with file masks. Pawn structures are cached in a pawn
+ * hash table, along with the squares each player's pawns attack. Mobility is
+ * counted from each piece's attacks, masked by the squares it may safely move
+ * to, and the pieces attacking and defending each piece are counted from the
+ * attack tables, so a board is scored without generating its moves. Any state
+ * shared while scoring a board is kept in a context which is local to the call,
+ * so a single evaluator may score boards on any number of threads at once, as
+ * long as each thread uses its own pawn hash table.
+ *
  * @author Timothy Flynn (trflynn89@gmail.com)
  * @version March 3, 2013
  */
@@ -29,28 +41,145 @@ public:
     /**
      * Evaluate the score of the whole board.
      *
-     * @param std::shared_ptr<BitBoard> The board to evaluate.
-     * @param ValidMoveSet All valid moves for the board.
+     * @param BitBoard The board to evaluate.
+     * @param bool True if the player in turn has any legal moves.
+     * @param PawnHashTable The table caching the evaluation of pawn structures.
      *
      * @return The board's score.
      */
-    int Score(const std::shared_ptr<BitBoard> &, const ValidMoveSet &) const;
+    int Score(BitBoard &, bool, PawnHashTable &) const;
+
+    /**
+     * Get the material value of a type of piece.
+     *
+     * @param piece_type The type of piece.
+     *
+     * @return The piece's value.
+     */
+    static value_type GetPieceValue(const piece_type &);
+
+    /**
+     * Mark a board as being in the end game phase, if few enough pieces remain.
+     * Scoring a board also updates its phase.
+     *
+     * @param BitBoard The board to update.
+     */
+    static void UpdateGamePhase(BitBoard &);
 
 private:
+    /**
+     * State shared by the evaluation of every piece of a single board.
+     */
+    struct EvaluationContext
+    {
+        EvaluationContext(const BitBoard &, const PawnHashTable::Entry &);
+
+        const BitBoard &m_board;
+
+        // Squares occupied by either player
+        board_type m_occupied;
+
+        // Squares each player's pieces, and each player's king, may safely
+        // move to, indexed by color
+        std::array<board_type, NONE> m_safeSquares;
+        std::array<board_type, NONE> m_kingSafeSquares;
+    };
+
+    /**
+     * Evaluate the score of every piece of one type and color on a board.
+     *
+     * @param EvaluationContext The board's evaluation context.
+     * @param piece_type The type of piece.
+     * @param color_type The color of the pieces.
+     *
+     * @return The pieces' combined score.
+     */
+    int evaluatePieces(const EvaluationContext &, const piece_type &, const color_type &) const;
+
+    /**
+     * Evaluate the pawn structure of a board, and the squares each player's
+     * pawns attack.
+     *
+     * @param BitBoard The board to evaluate.
+     *
+     * @return The pawn structure's entry for the pawn hash table.
+     */
+    PawnHashTable::Entry evaluatePawns(const BitBoard &) const;
+
+    /**
+     * Evaluate the structure of one player's pawns: doubled, isolated, and
+     * passed pawns.
+     *
+     * @param BitBoard The board to evaluate.
+     * @param color_type The color of the pawns.
+     *
+     * @return The pawn structure's score.
+     */
+    int evaluatePawnStructure(const BitBoard &, const color_type &) const;
+
+    /**
+     * Evaluate the mobility of a single piece on a board: the number of squares
+     * it attacks which are safe to move to, or for pawns, the number of pushes
+     * and captures it may make.
+     *
+     * @param EvaluationContext The board's evaluation context.
+     * @param piece_type The type of the piece.
+     * @param color_type The color of the piece.
+     * @param square_type The location of the piece.
+     *
+     * @return The piece's mobility.
+     */
+    int evaluateMobility(
+        const EvaluationContext &,
+        const piece_type &,
+        const color_type &,
+        const square_type &) const;
+
+    /**
+     * Weigh the pieces of one color which defend a piece of the same color.
+     * Only pawns, bishops, rooks, and queens are counted, cheaper pieces
+     * weighing more.
+     *
+     * @param EvaluationContext The board's evaluation context.
+     * @param color_type The color of the defending pieces.
+     * @param square_type The location of the defended piece.
+     *
+     * @return The weight of the defending pieces.
+     */
+    value_type evaluateDefenders(
+        const EvaluationContext &,
+        const color_type &,
+        const square_type &) const;
+
+    /**
+     * Weigh the pieces of one color which threaten to capture a piece of the
+     * other color. Only pawns and knights are counted, pawns weighing more.
+     *
+     * @param EvaluationContext The board's evaluation context.
+     * @param color_type The color of the attacking pieces.
+     * @param square_type The location of the attacked piece.
+     *
+     * @return The weight of the attacking pieces.
+     */
+    value_type evaluateAttackers(
+        const EvaluationContext &,
+        const color_type &,
+        const square_type &) const;
+
     /**
      * Evaluate the score of a single piece on a board.
      *
-     * @param std::shared_ptr<BitBoard> The board to evaluate.
-     * @param ValidMoveSet All valid moves for the board.
-     * @param square_type The rank of the piece.
-     * @param square_type The file of the piece.
+     * @param EvaluationContext The board's evaluation context.
+     * @param piece_type The type of the piece.
+     * @param color_type The color of the piece.
+     * @param square_type The location of the piece.
      *
      * @return The piece's score.
      */
     int evaluateSinglePiece(
-        const std::shared_ptr<BitBoard> &,
-        const ValidMoveSet &,
-        const square_type &,
+        const EvaluationContext &,
+        const piece_type &,
+        const color_type &,
         const square_type &) const;
 
     color_type m_engineColor;
@@ -0,0 +1,103 @@
+#include "move_history.h"
+
+namespace chessmate {
+
+namespace {
+
+    // History score at which every score is halved, so that the scores do not
+    // overflow and recent cutoffs outweigh old ones
+    const int s_maxHistoryScore = 1 << 20;
+
+} // namespace
+
+//==================================================================================================
+MoveHistory::MoveHistory()
+{
+    Clear();
+}
+
+//==================================================================================================
+void MoveHistory::Clear()
+{
+    for (auto &pieces : m_history)
+    {
+        for (auto &squares : pieces)
+        {
+            squares.fill(0);
+        }
+    }
+
+    for (auto &pieces : m_counterMoves)
+    {
+        for (auto &squares : pieces)
+        {
+            squares.fill(PackedMove());
+        }
+    }
+}
+
+//==================================================================================================
+void MoveHistory::NewSearch()
+{
+    age();
+}
+
+//==================================================================================================
+void MoveHistory::Update(
+    const color_type &color,
+    const Move &move,
+    const Move &previous,
+    const value_type &depth)
+{
+    const square_type end = GET_SQUARE(move.GetEndRank(), move.GetEndFile());
+    int &score = m_history[color][move.GetMovingPiece()][end];
+
+    score += depth * depth;
+
+    if (score >= s_maxHistoryScore)
+    {
+        age();
+    }
+
+    if (previous.GetMovingPiece() >= PAWN)
+    {
+        const square_type previousEnd = GET_SQUARE(previous.GetEndRank(), previous.GetEndFile());
+        m_counterMoves[color][previous.GetMovingPiece()][previousEnd] = PackedMove(move);
+    }
+}
+
+//==================================================================================================
+int MoveHistory::GetScore(const color_type &color, const Move &move) const
+{
+    const square_type end = GET_SQUARE(move.GetEndRank(), move.GetEndFile());
+    return m_history[color][move.GetMovingPiece()][end];
+}
+
+//==================================================================================================
+PackedMove MoveHistory::GetCounterMove(const color_type &color, const Move &previous) const
+{
+    if (previous.GetMovingPiece() < PAWN)
+    {
+        return PackedMove();
+    }
+
+    const square_type previousEnd = GET_SQUARE(previous.GetEndRank(), previous.GetEndFile());
+    return m_counterMoves[color][previous.GetMovingPiece()][previousEnd];
+}
+
+//==================================================================================================
+void MoveHistory::age()
+{
+    for (auto &pieces : m_history)
+    {
+        for (auto &squares : pieces)
+        {
+            for (int &score : squares)
+            {
+                score /= 2;
+            }
+        }
+    }
+}
+
+} // namespace chessmate
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "game/board_types.h"
+#include "movement/move.h"
+#include "movement/packed_move.h"
+
+#include <array>
+
+namespace chessmate {
+
+/**
+ * Class to remember which quiet moves caused cutoffs during a search, to order
+ * quiet moves at other nodes:
+ *
+ * - The history (butterfly) table scores each player's moves by the moving
+ *   piece and its destination. A cutoff adds a bonus which grows with the
+ *   depth of the node, since cutoffs near the root prune more of the tree.
+ * - The countermove table records the quiet move which last refuted each
+ *   previous move, also by the previous move's piece and destination.
+ *
+ * The tables are not thread-safe; each search thread owns its own.
+ *
+ * @author Timothy Flynn (trflynn89@gmail.com)
+ * @version October 17, 2026
+ */
+class MoveHistory
+{
+public:
+    /**
+     * Constructor. Creates empty tables.
+     */
+    MoveHistory();
+
+    /**
+     * Clear both tables.
+     */
+    void Clear();
+
+    /**
+     * Start a new search. History scores of earlier searches are kept, but
+     * weigh less than those of the new search.
+     */
+    void NewSearch();
+
+    /**
+     * Record a quiet move which caused a cutoff.
+     *
+     * @param color_type The color of the moving player.
+     * @param Move The move which caused the cutoff.
+     * @param Move The opponent's move preceding it, if any.
+     * @param value_type The remaining depth of the node.
+     */
+    void Update(const color_type &, const Move &, const Move &, const value_type &);
+
+    /**
+     * Get the history score of a quiet move.
+     *
+     * @param color_type The color of the moving player.
+     * @param Move The move to score.
+     *
+     * @return The move's history score.
+     */
+    int GetScore(const color_type &, const Move &) const;
+
+    /**
+     * Get the quiet move which last refuted a move.
+     *
+     * @param color_type The color of the player refuting the move.
+     * @param Move The move to refute.
+     *
+     * @return The refuting move, or the null move if there is none.
+     */
+    PackedMove GetCounterMove(const color_type &, const Move &) const;
+
+private:
+    /**
+     * Halve every history score.
+     */
+    void age();
+
+    // History scores, indexed by color, piece, and destination square
+    std::array<std::array<std::array<int, BOARD_SIZE>, KING + 1>, NONE> m_history;
+
+    // Countermoves, indexed by the refuting color, and the refuted move's piece
+    // and destination square
+    std::array<std::array<std::array<PackedMove, BOARD_SIZE>, KING + 1>, NONE> m_counterMoves;
+};
+
+} // namespace chessmate
@@ -0,0 +1,292 @@
+#include "move_picker.h"
+
+#include "engine/evaluator.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace chessmate {
+
+namespace {
+
+    // Weight of a good capture's victim when ordering it, more than any piece
+    // which may capture it is worth, so that the victim is ordered by first
+    const int s_victimWeight = 1024;
+
+} // namespace
+
+//==================================================================================================
+MovePicker::MovePicker(
+    BitBoard &board,
+    ValidMoveSet &validMoves,
+    MoveList &moves,
+    const PackedMove &ttMove,
+    const std::array<PackedMove, 2> &killers,
+    const PackedMove &counterMove,
+    const MoveHistory &history) :
+    m_board(board),
+    m_validMoves(validMoves),
+    m_moves(moves),
+    m_history(history),
+    m_generateMoves(true),
+    m_skipBadCaptures(false),
+    m_ttMove(ttMove),
+    m_refutations({killers[0], killers[1], counterMove}),
+    m_stage(TT_MOVE),
+    m_goodCursor(0),
+    m_goodEnd(0),
+    m_badCursor(0),
+    m_capturesEnd(0),
+    m_quietCursor(0),
+    m_refutationIndex(0)
+{
+    m_moves.clear();
+}
+
+//==================================================================================================
+MovePicker::MovePicker(
+    BitBoard &board,
+    ValidMoveSet &validMoves,
+    MoveList &moves,
+    const MoveHistory &history,
+    bool skipBadCaptures) :
+    MovePicker(board, validMoves, moves, PackedMove(), {}, PackedMove(), history)
+{
+    m_generateMoves = false;
+    m_skipBadCaptures = skipBadCaptures;
+}
+
+//==================================================================================================
+bool MovePicker::Next(Move &move)
+{
+    switch (m_stage)
+    {
+        case TT_MOVE:
+            m_stage = CAPTURES_INIT;
+
+            if (!m_ttMove.IsNull())
+            {
+                if (m_validMoves.FindLegalMove(m_board, m_ttMove, move))
+                {
+                    return true;
+                }
+
+                m_ttMove = PackedMove();
+            }
+
+            [[fallthrough]];
+
+        case CAPTURES_INIT:
+            partitionCaptures();
+            m_stage = GOOD_CAPTURES;
+            [[fallthrough]];
+
+        case GOOD_CAPTURES:
+            if (m_goodCursor < m_goodEnd)
+            {
+                takeBest(m_goodCursor, m_goodEnd, move);
+                return true;
+            }
+
+            m_stage = KILLERS;
+            [[fallthrough]];
+
+        case KILLERS:
+            if (takeRefutation(move))
+            {
+                return true;
+            }
+
+            m_stage = QUIETS_INIT;
+            [[fallthrough]];
+
+        case QUIETS_INIT:
+            scoreQuiets();
+            m_stage = QUIETS;
+            [[fallthrough]];
+
+        case QUIETS:
+            if (m_quietCursor < m_moves.size())
+            {
+                takeBest(m_quietCursor, m_moves.size(), move);
+                return true;
+            }
+
+            m_stage = BAD_CAPTURES;
+            [[fallthrough]];
+
+        case BAD_CAPTURES:
+            if (!m_skipBadCaptures && (m_badCursor < m_capturesEnd))
+            {
+                takeBest(m_badCursor, m_capturesEnd, move);
+                return true;
+            }
+
+            m_stage = DONE;
+            [[fallthrough]];
+
+        case DONE:
+            break;
+    }
+
+    return false;
+}
+
+//==================================================================================================
+void MovePicker::TakeRemaining(MoveList &moves)
+{
+    Move move;
+
+    while (Next(move))
+    {
+        moves.push_back(move);
+    }
+}
+
+//==================================================================================================
+void MovePicker::partitionCaptures()
+{
+    if (m_generateMoves)
+    {
+        m_validMoves.GenerateCaptures(m_board);
+    }
+
+    // The refutations are not tried until the good captures are picked, so only
+    // the transposition table move may have been picked already
+    for (const Move &move : m_validMoves.GetMyValidMoves())
+    {
+        if (PackedMove(move) != m_ttMove)
+        {
+            m_moves.push_back(move);
+        }
+    }
+
+    auto capturesEnd = std::partition(m_moves.begin(), m_moves.end(), [](const Move &move) {
+        return move.IsCapture();
+    });
+
+    m_capturesEnd = static_cast<MoveList::size_type>(capturesEnd - m_moves.begin());
+    m_quietCursor = m_capturesEnd;
+    m_goodEnd = m_goodCursor;
+
+    for (MoveList::size_type i = m_goodCursor; i < m_capturesEnd; ++i)
+    {
+        const piece_type moving = m_moves[i].GetMovingPiece();
+
+        // A king only captures when it is safe to, so it is never the more
+        // valuable piece
+        const int victim = Evaluator::GetPieceValue(m_board.GetCapturedPiece(m_moves[i]));
+        const int attacker = ((moving == KING) ? 0 : Evaluator::GetPieceValue(moving));
+
+        // A capture of a piece worth at least as much as the capturing piece
+        // cannot lose material, otherwise the exchange it starts is evaluated
+        bool good = (victim >= attacker);
+        value_type exchange = 0;
+
+        if (!good)
+        {
+            exchange = m_board.EvaluateExchange(m_moves[i]);
+            good = (exchange >= 0);
+        }
+
+        // Good captures are scored by most valuable victim first, then least
+        // valuable attacker, and bad captures by the material they lose
+        if (good)
+        {
+            m_scores[i] = (victim * s_victimWeight) - attacker;
+
+            std::swap(m_moves[i], m_moves[m_goodEnd]);
+            std::swap(m_scores[i], m_scores[m_goodEnd]);
+            ++m_goodEnd;
+        }
+        else
+        {
+            m_scores[i] = exchange;
+        }
+    }
+
+    m_badCursor = m_goodEnd;
+}
+
+//==================================================================================================
+bool MovePicker::takeRefutation(Move &move)
+{
+    while (m_refutationIndex < m_refutations.size())
+    {
+        PackedMove &refutation = m_refutations[m_refutationIndex];
+
+        // A refutation which matches a move already picked is not picked again
+        const auto earlier = m_refutations.begin() + m_refutationIndex;
+        const bool picked = (refutation == m_ttMove) ||
+            (std::find(m_refutations.begin(), earlier, refutation) != earlier);
+
+        ++m_refutationIndex;
+
+        if (!refutation.IsNull() && !picked &&
+            m_validMoves.FindLegalMove(m_board, refutation, move) && !move.IsCapture())
+        {
+            return true;
+        }
+
+        refutation = PackedMove();
+    }
+
+    return false;
+}
+
+//==================================================================================================
+void MovePicker::scoreQuiets()
+{
+    if (m_generateMoves)
+    {
+        m_validMoves.GenerateQuiets(m_board);
+
+        for (const Move &move : m_validMoves.GetMyValidMoves())
+        {
+            if (!wasPicked(move))
+            {
+                m_moves.push_back(move);
+            }
+        }
+    }
+
+    const color_type color = m_board.GetPlayerInTurn();
+
+    for (MoveList::size_type i = m_quietCursor; i < m_moves.size(); ++i)
+    {
+        m_scores[i] = m_history.GetScore(color, m_moves[i]);
+    }
+}
+
+//==================================================================================================
+void MovePicker::takeBest(
+    MoveList::size_type &cursor,
+    const MoveList::size_type &end,
+    Move &move)
+{
+    MoveList::size_type best = cursor;
+
+    for (MoveList::size_type i = cursor + 1; i < end; ++i)
+    {
+        if (m_scores[i] > m_scores[best])
+        {
+            best = i;
+        }
+    }
+
+    std::swap(m_moves[cursor], m_moves[best]);
+    std::swap(m_scores[cursor], m_scores[best]);
+
+    move = m_moves[cursor++];
+}
+
+//==================================================================================================
+bool MovePicker::wasPicked(const Move &move) const
+{
+    const PackedMove packed(move);
+
+    return (packed == m_ttMove) ||
+        (std::find(m_refutations.begin(), m_refutations.end(), packed) != m_refutations.end());
+}
+
+} // namespace chessmate
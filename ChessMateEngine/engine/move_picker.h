@@ -0,0 +1,179 @@
+#pragma once
+
+#include "engine/move_history.h"
+#include "game/bit_board.h"
+#include "game/board_types.h"
+#include "movement/move.h"
+#include "movement/move_list.h"
+#include "movement/packed_move.h"
+#include "movement/valid_move_set.h"
+
+#include <array>
+#include <cstddef>
+
+namespace chessmate {
+
+/**
+ * Class to hand out the moves of a node one at a time, in the order they are
+ * most likely to cause a cutoff:
+ *
+ * 1. The transposition table's best move.
+ * 2. Good captures, most valuable victim first, least valuable attacker next.
+ * 3. Killer moves, quiet moves which caused a cutoff at the same ply, and the
+ *    countermove, the quiet move which last refuted the previous move.
+ * 4. The remaining quiet moves, by their history score.
+ * 5. Bad captures, which lose material per static exchange evaluation, least
+ *    losing first.
+ *
+ * Each stage is generated only once the previous stage runs out: the
+ * transposition table move and the killer moves are checked for legality on
+ * their own, captures are generated only if those do not cut the node off, and
+ * quiet moves only if the captures do not either. Moves are picked by a
+ * selection pass rather than sorted up front, so a node which is cut off after
+ * its first few moves does no generation or ordering work for the rest.
+ *
+ * The picker collects the moves it generates in the given list, and must not
+ * outlive it.
+ *
+ * @author Timothy Flynn (trflynn89@gmail.com)
+ * @version October 17, 2026
+ */
+class MovePicker
+{
+public:
+    /**
+     * Constructor. The node's moves are generated in stages as they are picked.
+     *
+     * @param BitBoard The board the moves are to be made on.
+     * @param ValidMoveSet The set to generate the node's moves with.
+     * @param MoveList The list to collect the node's moves in.
+     * @param PackedMove The transposition table's best move, if any.
+     * @param array The killer moves of the node's ply.
+     * @param PackedMove The countermove to the previous move, if any.
+     * @param MoveHistory The history scores to order quiet moves by.
+     */
+    MovePicker(
+        BitBoard &,
+        ValidMoveSet &,
+        MoveList &,
+        const PackedMove &,
+        const std::array<PackedMove, 2> &,
+        const PackedMove &,
+        const MoveHistory &);
+
+    /**
+     * Constructor for the quiescence search, which has no transposition table
+     * move or killer moves. The moves already generated by the given set, its
+     * captures or check evasions, are picked without generating any others.
+     *
+     * @param BitBoard The board the moves are to be made on.
+     * @param ValidMoveSet The set holding the node's moves.
+     * @param MoveList The list to collect the node's moves in.
+     * @param MoveHistory The history scores to order quiet moves by.
+     * @param bool True if bad captures should be skipped rather than picked.
+     */
+    MovePicker(BitBoard &, ValidMoveSet &, MoveList &, const MoveHistory &, bool);
+
+    /**
+     * Take the next move to search.
+     *
+     * @param Move The move to fill.
+     *
+     * @return True if a move was taken, false if none remain.
+     */
+    bool Next(Move &);
+
+    /**
+     * Take every remaining move, in the order they would have been picked.
+     *
+     * @param MoveList The list to fill.
+     */
+    void TakeRemaining(MoveList &);
+
+private:
+    /**
+     * Enumerated list of the stages moves are picked in.
+     */
+    enum Stage
+    {
+        TT_MOVE,
+        CAPTURES_INIT,
+        GOOD_CAPTURES,
+        KILLERS,
+        QUIETS_INIT,
+        QUIETS,
+        BAD_CAPTURES,
+        DONE
+    };
+
+    /**
+     * Collect the node's captures, unless the quiescence search already
+     * generated its moves, and move the captures to the front of the unpicked
+     * moves, good captures first, scoring them for ordering.
+     */
+    void partitionCaptures();
+
+    /**
+     * Find the next killer move or countermove which is a legal quiet move and
+     * has not already been picked.
+     *
+     * @param Move The move to fill.
+     *
+     * @return True if a move was found.
+     */
+    bool takeRefutation(Move &);
+
+    /**
+     * Collect the node's quiet moves, unless the quiescence search already
+     * generated its moves, and score them by their history scores.
+     */
+    void scoreQuiets();
+
+    /**
+     * Take the highest scored move from a group of moves, moving it to the
+     * front of the group.
+     *
+     * @param size_type The cursor of the group, advanced past the taken move.
+     * @param size_type The end of the group.
+     * @param Move The move to fill.
+     */
+    void takeBest(MoveList::size_type &, const MoveList::size_type &, Move &);
+
+    /**
+     * Check if a move was already picked in the transposition table or killer
+     * stages.
+     *
+     * @param Move The move to check.
+     *
+     * @return True if the move was already picked.
+     */
+    bool wasPicked(const Move &) const;
+
+    BitBoard &m_board;
+    ValidMoveSet &m_validMoves;
+    MoveList &m_moves;
+    const MoveHistory &m_history;
+    bool m_generateMoves;
+    bool m_skipBadCaptures;
+
+    // The transposition table move and the refutations, each cleared if it is
+    // not picked, so that they may be skipped once the rest are generated
+    PackedMove m_ttMove;
+    std::array<PackedMove, 3> m_refutations;
+
+    Stage m_stage;
+
+    // Once captures are partitioned, the collected moves are grouped as good
+    // captures, then bad captures, then quiet moves. Each group is picked from
+    // by its own cursor.
+    MoveList::size_type m_goodCursor;
+    MoveList::size_type m_goodEnd;
+    MoveList::size_type m_badCursor;
+    MoveList::size_type m_capturesEnd;
+    MoveList::size_type m_quietCursor;
+    std::size_t m_refutationIndex;
+
+    std::array<int, MoveList::s_capacity> m_scores;
+};
+
+} // namespace chessmate
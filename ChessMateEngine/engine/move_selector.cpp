@@ -1,141 +1,1167 @@
 #include "move_selector.h"
 
-#include "movement/valid_move_set.h"
+#include "engine/move_picker.h"
 
-#include <fly/fly.hpp>
+#include <fly/logger/logger.hpp>
+#include <fly/task/task_runner.hpp>
+#include <fly/types/numeric/literals.hpp>
 
 #include <algorithm>
+#include <bit>
+#include <thread>
+
+using namespace fly::literals::numeric_literals;
 
 namespace chessmate {
 
 namespace {
     static const int s_posInfinity = 32767;
     static const int s_negInfinity = -32767;
+
+    // Number of nodes searched between checks of the search deadline
+    static const std::uint64_t s_nodesPerTimeCheck = 1024;
+
+    // Minimum depth of a node for its moves to be searched in parallel
+    static const value_type s_minSplitDepth = 3;
+
+    // Deepest search supported by the preallocated search stack
+    static const value_type s_maxSearchDepth = 64;
+
+    // Deepest ply supported by the preallocated search stack, leaving room for
+    // the quiescence search beyond the max depth
+    static const value_type s_maxSearchPly = s_maxSearchDepth * 2;
+
+    // Frames in the search stack: one per ply, including the root
+    static const std::size_t s_searchStackSize = s_maxSearchPly + 1;
+
+    // Half-width of the root's first aspiration window around the previous
+    // iteration's score
+    static const int s_aspirationWindow = 50;
+
+    // Minimum depth of a node to try a null move at, and the depth by which the
+    // null move's search is reduced (plus one more for deep nodes)
+    static const value_type s_nullMoveMinDepth = 3;
+    static const value_type s_nullMoveReduction = 2;
+    static const value_type s_nullMoveDeepDepth = 7;
+
+    // Most pieces other than pawns and the king which the player in turn may
+    // have for a null move cutoff to be verified, as zugzwang is more likely
+    static const int s_nullMoveVerifyPieces = 2;
+
+    // Minimum depth of a node, and number of moves searched before a move, for
+    // the move to be reduced
+    static const value_type s_minReductionDepth = 3;
+    static const MoveList::size_type s_minReductionMoves = 3;
+
+    // Margin added to the value of a captured piece before delta pruning the
+    // capture, for positional gains the capture may also make
+    static const value_type s_deltaMargin = 200;
+
+    // Number of entries in each thread's pawn hash table
+    static const std::size_t s_pawnHashTableSize = 1 << 14;
 } // namespace
 
+//==================================================================================================
+MoveSelector::SearchFrame::SearchFrame() : m_staticScore(0)
+{
+}
+
 //==================================================================================================
 MoveSelector::MoveSelector(
     const std::shared_ptr<MoveSet> &spMoveSet,
     const std::shared_ptr<BitBoard> &spBoard,
+    const std::shared_ptr<TranspositionTable> &spTranspositionTable,
+    const std::shared_ptr<SearchParameters> &spSearchParameters,
+    std::size_t evaluationCacheSize,
+    const std::shared_ptr<fly::task::ParallelTaskRunner> &spTaskRunner,
+    unsigned int searchThreads,
+    ParallelMode parallelMode,
     const color_type &engineColor) :
-    m_wpMoveSet(spMoveSet),
+    m_spMoveSet(spMoveSet),
     m_wpBoard(spBoard),
+    m_spTranspositionTable(spTranspositionTable),
+    m_spSearchParameters(spSearchParameters),
+    m_evaluationCacheSize(evaluationCacheSize),
+    m_spTaskRunner(spTaskRunner),
     m_engineColor(engineColor),
-    m_evaluator(engineColor)
+    m_evaluator(engineColor),
+    m_searchThreads(std::clamp(searchThreads, 1u, SplitPoint::s_maxThreads)),
+    m_threadIndex(0),
+    m_parallelMode(parallelMode),
+    m_spSplitPointStats(std::make_shared<SplitPointStats>()),
+    m_spSearchStats(std::make_shared<SearchStats>()),
+    m_spSearchStack(std::make_shared<std::vector<SearchFrame>>(s_searchStackSize)),
+    m_spMoveHistory(std::make_shared<MoveHistory>()),
+    m_spPawnHashTable(std::make_shared<PawnHashTable>(s_pawnHashTableSize)),
+    m_spEvaluationCache(std::make_shared<EvaluationCache>(evaluationCacheSize)),
+    m_hasDeadline(false),
+    m_spStopSearch(std::make_shared<std::atomic_bool>(false)),
+    m_nodeCount(0),
+    m_spRunningHelpers(std::make_shared<std::atomic<unsigned int>>(0)),
+    m_bestScore(0),
+    m_nullMoveMinPly(0)
 {
-    FLY_UNUSED(m_engineColor);
 }
 
 //==================================================================================================
-Move MoveSelector::GetBestMove(const value_type &maxDepth) const
+Move MoveSelector::GetBestMove(
+    const value_type &maxDepth,
+    const std::chrono::milliseconds &timeBudget)
 {
-    std::shared_ptr<BitBoard> spBoard = m_wpBoard.lock();
+    // Search on a private copy of the game's board, making and unmaking moves
+    // on that copy in place
+    BitBoard board(*m_wpBoard.lock());
+    m_spTranspositionTable->NewSearch();
 
-    ValidMoveSet vms(m_wpMoveSet, spBoard);
-    MoveList moves = vms.GetMyValidMoves();
+    // Every node of the search uses a frame of the search stack
+    const value_type depth = std::min(maxDepth, s_maxSearchDepth);
+
+    // Killer moves of the previous search are from a different position
+    for (SearchFrame &frame : *m_spSearchStack)
+    {
+        frame.m_killers.fill(PackedMove());
+    }
+
+    m_spMoveHistory->NewSearch();
+
+    m_deadline = std::chrono::steady_clock::now() + timeBudget;
+    m_spStopSearch = std::make_shared<std::atomic_bool>(false);
+    m_spRunningHelpers = std::make_shared<std::atomic<unsigned int>>(0);
+    m_spSplitPointStats = std::make_shared<SplitPointStats>();
+    m_spSearchStats = std::make_shared<SearchStats>();
+    m_spSplitPointQueues.reset();
+
+    if ((m_parallelMode == YOUNG_BROTHERS_WAIT) && (m_searchThreads > 1))
+    {
+        m_spSplitPointQueues = std::make_shared<std::vector<SplitPointQueue>>(m_searchThreads);
+    }
+
+    startHelpers(board, depth, timeBudget);
+    Move bestMove = searchRoot(board, depth, timeBudget);
+
+    // Helpers return as soon as they see the stop flag, having added their node
+    // counts to the search's statistics
+    m_spStopSearch->store(true, std::memory_order_relaxed);
+    waitForHelpers();
+
+    m_spSearchStats->m_nodes.fetch_add(m_nodeCount, std::memory_order_relaxed);
+
+    if (m_spSplitPointQueues)
+    {
+        LOGD(
+            "Split points: {} created, {} steals, {} stolen moves, {} cut off",
+            m_spSplitPointStats->m_splitPoints.load(),
+            m_spSplitPointStats->m_steals.load(),
+            m_spSplitPointStats->m_stolenMoves.load(),
+            m_spSplitPointStats->m_cutoffs.load());
+    }
+
+    LOGD(
+        "Search: {} reductions, {} re-searches, {} futility prunes, {} razor prunes",
+        m_spSearchStats->m_reductions.load(),
+        m_spSearchStats->m_reSearches.load(),
+        m_spSearchStats->m_futilityPrunes.load(),
+        m_spSearchStats->m_razorPrunes.load());
+
+    LOGD(
+        "Evaluation cache: {} hits, {} misses",
+        m_spSearchStats->m_evaluationCacheHits.load(),
+        m_spSearchStats->m_evaluationCacheMisses.load());
+
+    return bestMove;
+}
+
+//==================================================================================================
+value_type MoveSelector::GetBestScore() const
+{
+    return m_bestScore;
+}
+
+//==================================================================================================
+const SplitPointStats &MoveSelector::GetSplitPointStats() const
+{
+    return *m_spSplitPointStats;
+}
+
+//==================================================================================================
+const SearchStats &MoveSelector::GetSearchStats() const
+{
+    return *m_spSearchStats;
+}
+
+//==================================================================================================
+void MoveSelector::startHelpers(
+    const BitBoard &board,
+    const value_type &maxDepth,
+    const std::chrono::milliseconds &timeBudget)
+{
+    if (!m_spTaskRunner)
+    {
+        return;
+    }
+
+    for (unsigned int i = 1; i < m_searchThreads; ++i)
+    {
+        auto spHelper = std::make_shared<MoveSelector>(*this);
+        spHelper->m_threadIndex = i;
+        spHelper->m_nodeCount = 0;
+        spHelper->m_spSearchStack = std::make_shared<std::vector<SearchFrame>>(s_searchStackSize);
+        spHelper->m_spMoveHistory = std::make_shared<MoveHistory>();
+        spHelper->m_spPawnHashTable = std::make_shared<PawnHashTable>(s_pawnHashTableSize);
+        spHelper->m_spEvaluationCache = std::make_shared<EvaluationCache>(m_evaluationCacheSize);
+
+        auto spBoard = std::make_shared<BitBoard>(board);
+
+        auto task = [spHelper, spBoard, maxDepth, timeBudget]()
+        {
+            if (spHelper->m_spSplitPointQueues)
+            {
+                spHelper->helpSplitPoints();
+            }
+            else
+            {
+                spHelper->searchRoot(*spBoard, maxDepth, timeBudget);
+            }
+
+            spHelper->m_spSearchStats->m_nodes.fetch_add(
+                spHelper->m_nodeCount,
+                std::memory_order_relaxed);
+
+            spHelper->m_spRunningHelpers->fetch_sub(1, std::memory_order_release);
+            spHelper->m_spRunningHelpers->notify_all();
+        };
+
+        m_spRunningHelpers->fetch_add(1, std::memory_order_relaxed);
+
+        if (!m_spTaskRunner->post_task(FROM_HERE, std::move(task)))
+        {
+            LOGW("Could not start helper search {} of {}", i, m_searchThreads - 1);
+            m_spRunningHelpers->fetch_sub(1, std::memory_order_relaxed);
+            break;
+        }
+    }
+}
+
+//==================================================================================================
+void MoveSelector::waitForHelpers() const
+{
+    unsigned int running = m_spRunningHelpers->load(std::memory_order_acquire);
+
+    while (running != 0)
+    {
+        m_spRunningHelpers->wait(running, std::memory_order_acquire);
+        running = m_spRunningHelpers->load(std::memory_order_acquire);
+    }
+}
+
+//==================================================================================================
+Move MoveSelector::searchRoot(
+    BitBoard &board,
+    const value_type &maxDepth,
+    const std::chrono::milliseconds &timeBudget)
+{
+    // The first iteration is always completed, so there is a move to fall back
+    // to, and the deadline is only enforced after it
+    m_hasDeadline = false;
+    m_nodeCount = 0;
+    m_bestScore = 0;
+    m_nullMoveMinPly = 0;
+
+    // The root's moves are kept in its frame, so that each iteration may
+    // reorder them for the next
+    SearchFrame &frame = (*m_spSearchStack)[0];
+    frame.m_validMoves.Generate(*m_spMoveSet, board);
+
+    MoveList &moves = frame.m_moves;
+    moves.assign(
+        frame.m_validMoves.GetMyValidMoves().begin(),
+        frame.m_validMoves.GetMyValidMoves().end());
 
-    value_type bestValue = s_negInfinity;
     Move bestMove;
+    value_type previousValue = 0;
+
+    // Odd helpers skip ahead a depth, so the threads do not all search the same
+    // depth at the same time
+    const value_type firstDepth = 1 + (m_threadIndex % 2);
+
+    for (value_type depth = firstDepth; depth <= maxDepth; ++depth)
+    {
+        TranspositionTable::Entry entry;
+
+        // Search the previous iteration's best move first
+        if (m_spTranspositionTable->Probe(board.GetHashKey(), entry))
+        {
+            orderMoves(moves, entry.m_move);
+        }
+
+        // Helpers rotate the remaining moves, so each thread starts its search
+        // on a different part of the tree
+        if ((m_threadIndex > 0) && (moves.size() > 2))
+        {
+            std::size_t rotation = m_threadIndex % (moves.size() - 1);
+            std::rotate(moves.begin() + 1, moves.begin() + 1 + rotation, moves.end());
+        }
+
+        Move iterationMove = bestMove;
+        value_type bestValue = s_negInfinity;
+
+        int delta = s_aspirationWindow;
+        int alpha = s_negInfinity;
+        int beta = s_posInfinity;
+
+        // After the first iteration, the score is likely close to the previous
+        // iteration's, so the search starts with a narrow window around it
+        if (depth > firstDepth)
+        {
+            alpha = std::max(previousValue - delta, s_negInfinity);
+            beta = std::min(previousValue + delta, s_posInfinity);
+        }
+
+        while (true)
+        {
+            bestValue = searchRootMoves(
+                board,
+                moves,
+                depth,
+                static_cast<value_type>(alpha),
+                static_cast<value_type>(beta),
+                iterationMove);
+
+            if (wasSearchStopped())
+            {
+                break;
+            }
+
+            // If the score fell outside of the window, widen that side of the
+            // window and search again
+            delta *= 2;
+
+            if ((bestValue <= alpha) && (alpha > s_negInfinity))
+            {
+                alpha = std::max(bestValue - delta, s_negInfinity);
+            }
+            else if ((bestValue >= beta) && (beta < s_posInfinity))
+            {
+                beta = std::min(bestValue + delta, s_posInfinity);
+                orderMoves(moves, PackedMove(iterationMove));
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        if (wasSearchStopped())
+        {
+            if (m_threadIndex == 0)
+            {
+                LOGD("Search to depth {} ran out of time after {} nodes", depth, m_nodeCount);
+            }
+
+            break;
+        }
+
+        bestMove = iterationMove;
+        previousValue = bestValue;
+        m_bestScore = bestValue;
+
+        entry.m_move = PackedMove(bestMove);
+        entry.m_score = bestValue;
+        entry.m_depth = depth + 1;
+        entry.m_bound = TranspositionTable::EXACT;
+        m_spTranspositionTable->Store(board.GetHashKey(), entry);
+
+        if (m_threadIndex == 0)
+        {
+            LOGD(
+                "Searched to depth {}: best move {} ({}), {} nodes",
+                depth,
+                bestMove,
+                bestValue,
+                m_nodeCount);
+        }
+
+        // No deeper search can improve on a forced win
+        if (bestValue == s_posInfinity)
+        {
+            break;
+        }
+
+        m_hasDeadline = (timeBudget.count() > 0);
+    }
+
+    return bestMove;
+}
+
+//==================================================================================================
+value_type MoveSelector::searchRootMoves(
+    BitBoard &board,
+    MoveList &moves,
+    const value_type &depth,
+    value_type alpha,
+    const value_type &beta,
+    Move &bestMove)
+{
+    SearchFrame &frame = (*m_spSearchStack)[0];
+    value_type bestValue = s_negInfinity;
 
     for (auto it = moves.begin(); it != moves.end(); ++it)
     {
-        std::shared_ptr<BitBoard> spResult = result(spBoard, *it);
+        frame.m_currentMove = *it;
+        board.MakeMove(*it);
 
-        value_type oldVal = bestValue;
-        value_type min = minValue(spResult, maxDepth, s_negInfinity, s_posInfinity);
-        bestValue = std::max(bestValue, min);
+        value_type value = (it == moves.begin()) ?
+            -negamax(board, depth, 1, -beta, -alpha) :
+            searchLaterMove(board, depth, 1, alpha, beta, 0);
 
-        if (bestValue > oldVal)
+        board.UnmakeMove();
+
+        if (wasSearchStopped())
+        {
+            break;
+        }
+        else if (value > bestValue)
         {
+            bestValue = value;
             bestMove = *it;
         }
+
+        if (bestValue >= beta)
+        {
+            break;
+        }
+
+        alpha = std::max(alpha, bestValue);
     }
 
-    return bestMove;
+    return bestValue;
 }
 
 //==================================================================================================
-value_type MoveSelector::maxValue(
-    const std::shared_ptr<BitBoard> &spBoard,
+void MoveSelector::helpSplitPoints()
+{
+    while (!wasSearchStopped())
+    {
+        if (!stealSplitPoint(~0_u64, 0))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+//==================================================================================================
+bool MoveSelector::stealSplitPoint(const std::uint64_t &threads, const value_type &minPly)
+{
+    std::vector<SplitPointQueue> &queues = *m_spSplitPointQueues;
+    std::shared_ptr<SplitPoint> spSplitPoint;
+
+    // Look through the other threads' queues, starting with the next thread so
+    // that the helpers spread out
+    for (std::size_t i = 1; !spSplitPoint && (i < queues.size()); ++i)
+    {
+        const std::size_t thread = (m_threadIndex + i) % queues.size();
+
+        if ((threads >> thread) & 0x1)
+        {
+            spSplitPoint = queues[thread].Steal(minPly);
+        }
+    }
+
+    if (!spSplitPoint)
+    {
+        return false;
+    }
+
+    m_spSplitPointStats->m_steals.fetch_add(1, std::memory_order_relaxed);
+
+    BitBoard board(spSplitPoint->GetBoard());
+    searchSplitPoint(*spSplitPoint, board, false);
+
+    return true;
+}
+
+//==================================================================================================
+bool MoveSelector::shouldSplit(const value_type &depth) const
+{
+    return (m_spSplitPointQueues && (depth >= s_minSplitDepth));
+}
+
+//==================================================================================================
+bool MoveSelector::splitSearch(
+    BitBoard &board,
+    MoveList moves,
     const value_type &depth,
+    const value_type &ply,
+    value_type &alpha,
+    const value_type &beta,
+    value_type &v,
+    PackedMove &bestMove)
+{
+    auto spSplitPoint = std::make_shared<SplitPoint>(
+        board,
+        std::move(moves),
+        depth,
+        ply,
+        alpha,
+        beta,
+        v,
+        bestMove);
+
+    SplitPointQueue &queue = (*m_spSplitPointQueues)[m_threadIndex];
+    queue.Push(spSplitPoint);
+
+    m_spSplitPointStats->m_splitPoints.fetch_add(1, std::memory_order_relaxed);
+    searchSplitPoint(*spSplitPoint, board, true);
+
+    queue.Pop();
+
+    // Helpers may still be searching the last moves they took. Until they are
+    // done, help them with the split points they create beneath this one,
+    // which only use this thread's search stack deeper than this node.
+    while (!spSplitPoint->IsIdle())
+    {
+        if (!stealSplitPoint(spSplitPoint->GetActiveThreads(), ply + 1))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    if (wasSearchStopped())
+    {
+        return false;
+    }
+
+    v = spSplitPoint->GetBestValue();
+    bestMove = spSplitPoint->GetBestMove();
+    alpha = std::max(alpha, v);
+
+    return true;
+}
+
+//==================================================================================================
+void MoveSelector::searchSplitPoint(
+    SplitPoint &splitPoint,
+    BitBoard &board,
+    bool isOwner)
+{
+    splitPoint.Join(m_threadIndex);
+
+    const bool inCheck = isInCheck(board);
+
+    Move move;
+    value_type alpha = 0;
+    value_type beta = 0;
+    MoveList::size_type index = 0;
+
+    while (splitPoint.GetNextMove(move, alpha, beta, index))
+    {
+        const value_type depth = splitPoint.GetDepth() - 1;
+        const value_type ply = splitPoint.GetPly() + 1;
+
+        (*m_spSearchStack)[splitPoint.GetPly()].m_currentMove = move;
+        board.MakeMove(move);
+
+        // The split node's first move was searched before it was split
+        const value_type reduction =
+            lateMoveReduction(move, splitPoint.GetDepth(), index + 2, inCheck);
+        value_type value = searchLaterMove(board, depth, ply, alpha, beta, reduction);
+        board.UnmakeMove();
+
+        if (wasSearchStopped())
+        {
+            break;
+        }
+        else if (!isOwner)
+        {
+            m_spSplitPointStats->m_stolenMoves.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (splitPoint.Update(move, value))
+        {
+            m_spSplitPointStats->m_cutoffs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    splitPoint.Leave(m_threadIndex);
+}
+
+//==================================================================================================
+value_type MoveSelector::negamax(
+    BitBoard &board,
+    const value_type &depth,
+    const value_type &ply,
     value_type alpha,
-    value_type beta) const
+    const value_type &beta)
 {
-    ValidMoveSet vms(m_wpMoveSet, spBoard);
-    value_type score = m_evaluator.Score(spBoard, vms);
+    // The result of an abandoned search is discarded, so any value will do
+    if (isSearchStopped())
+    {
+        return 0;
+    }
+
+    // A position which has already occurred is scored as a draw, since the
+    // player in turn could keep repeating it
+    if (board.IsRepeatedPosition())
+    {
+        return 0;
+    }
 
-    if (reachedEndState(depth, score))
+    const hash_type key = board.GetHashKey();
+    TranspositionTable::Entry entry;
+
+    if (m_spTranspositionTable->Probe(key, entry) &&
+        isTranspositionCutoff(entry, depth, alpha, beta))
     {
-        return score;
+        return entry.m_score;
     }
 
-    MoveList moves = vms.GetMyValidMoves();
+    SearchFrame &frame = (*m_spSearchStack)[ply];
+
+    bool gameOver = false;
+
+    if ((depth <= 1) && m_spSearchParameters->IsExhaustive())
+    {
+        // An exhaustive search scores the nodes at the max depth as they stand
+        return evaluate(board, frame.m_validMoves, gameOver);
+    }
+    else if (depth <= 1)
+    {
+        return quiesce(board, ply, alpha, beta);
+    }
+
+    // Moves are only generated once they are picked, so that a node which is
+    // cut off early never generates its quiet moves
+    frame.m_staticScore = evaluate(board, frame.m_validMoves, gameOver);
+
+    if (gameOver)
+    {
+        return frame.m_staticScore;
+    }
+
+    const bool inCheck = isInCheck(board);
+
+    // Just above the max depth, a node whose static score is far below the
+    // window is unlikely to be raised to it by anything but a capture
+    const value_type razorMargin = m_spSearchParameters->GetRazorMargin(depth - 1);
+
+    if ((razorMargin > 0) && !inCheck && ((frame.m_staticScore + razorMargin) <= alpha))
+    {
+        const value_type value = quiesce(board, ply, alpha, alpha + 1);
+
+        if (wasSearchStopped())
+        {
+            return 0;
+        }
+        else if (value <= alpha)
+        {
+            m_spSearchStats->m_razorPrunes.fetch_add(1, std::memory_order_relaxed);
+            return value;
+        }
+    }
+
+    // If passing still fails high, even when searched to a reduced depth, then
+    // some real move almost certainly would too
+    if ((frame.m_staticScore >= beta) && canNullMove(board, depth, ply))
+    {
+        const value_type reduction = nullMoveReduction(depth);
+
+        frame.m_currentMove = Move();
+        board.MakeNullMove();
+        value_type value = -negamax(board, depth - 1 - reduction, ply + 1, -beta, -beta + 1);
+        board.UnmakeMove();
+
+        if (wasSearchStopped())
+        {
+            return 0;
+        }
+        else if ((value >= beta) && !needsNullMoveVerification(board))
+        {
+            return beta;
+        }
+        else if (value >= beta)
+        {
+            // Verify the cutoff with a reduced search of this node, without
+            // null moves near its root
+            const value_type nullMoveMinPly = m_nullMoveMinPly;
+            m_nullMoveMinPly = ply + ((depth - reduction) * 3 / 4);
+            value = negamax(board, depth - reduction, ply, beta - 1, beta);
+            m_nullMoveMinPly = nullMoveMinPly;
+
+            if (wasSearchStopped())
+            {
+                return 0;
+            }
+            else if (value >= beta)
+            {
+                return beta;
+            }
+        }
+    }
+
+    const PackedMove counterMove = m_spMoveHistory->GetCounterMove(
+        board.GetPlayerInTurn(),
+        (*m_spSearchStack)[ply - 1].m_currentMove);
+
+    MovePicker picker(
+        board,
+        frame.m_validMoves,
+        frame.m_moves,
+        entry.m_move,
+        frame.m_killers,
+        counterMove,
+        *m_spMoveHistory);
+    Move move;
+
+    const value_type futilityMargin = m_spSearchParameters->GetFutilityMargin(depth - 1);
+
+    const value_type originalAlpha = alpha;
     value_type v = s_negInfinity;
+    MoveList::size_type moveNumber = 0;
 
-    for (auto it = moves.begin(); it != moves.end(); ++it)
+    while (picker.Next(move))
     {
-        std::shared_ptr<BitBoard> spResult = result(spBoard, *it);
-        v = std::max(v, minValue(spResult, depth - 1, alpha, beta));
+        frame.m_currentMove = move;
+        board.MakeMove(move);
+        ++moveNumber;
 
-        if (score >= beta)
+        // Near the max depth, a quiet move cannot raise a static score far
+        // below the window to it
+        if ((moveNumber > 1) && (futilityMargin > 0) && !inCheck && isQuiet(move) &&
+            ((frame.m_staticScore + futilityMargin) <= alpha))
         {
-            return v;
+            board.UnmakeMove();
+            m_spSearchStats->m_futilityPrunes.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        value_type value = 0;
+
+        if (moveNumber == 1)
+        {
+            value = -negamax(board, depth - 1, ply + 1, -beta, -alpha);
+        }
+        else
+        {
+            const value_type reduction = lateMoveReduction(move, depth, moveNumber, inCheck);
+            value = searchLaterMove(board, depth - 1, ply + 1, alpha, beta, reduction);
+        }
+
+        board.UnmakeMove();
+
+        if (wasSearchStopped())
+        {
+            return 0;
+        }
+
+        if (value > v)
+        {
+            v = value;
+            entry.m_move = PackedMove(move);
+        }
+
+        if (v >= beta)
+        {
+            storeCutoff(board, depth, ply, move);
+            break;
         }
 
         alpha = std::max(alpha, v);
+
+        // Once the first move has been searched, the rest may be searched in
+        // parallel
+        if (shouldSplit(depth))
+        {
+            MoveList remaining;
+            picker.TakeRemaining(remaining);
+
+            if (!remaining.empty() &&
+                !splitSearch(
+                    board,
+                    std::move(remaining),
+                    depth,
+                    ply,
+                    alpha,
+                    beta,
+                    v,
+                    entry.m_move))
+            {
+                return 0;
+            }
+
+            break;
+        }
     }
 
+    // A search which was cut off has only found a lower bound of the score, and
+    // one which found nothing better than alpha only an upper bound
+    if (v >= beta)
+    {
+        entry.m_bound = TranspositionTable::LOWER;
+    }
+    else if (v <= originalAlpha)
+    {
+        entry.m_bound = TranspositionTable::UPPER;
+    }
+    else
+    {
+        entry.m_bound = TranspositionTable::EXACT;
+    }
+
+    entry.m_score = v;
+    entry.m_depth = depth;
+    m_spTranspositionTable->Store(key, entry);
+
     return v;
 }
 
 //==================================================================================================
-value_type MoveSelector::minValue(
-    const std::shared_ptr<BitBoard> &spBoard,
+value_type MoveSelector::searchLaterMove(
+    BitBoard &board,
     const value_type &depth,
-    value_type alpha,
-    value_type beta) const
+    const value_type &ply,
+    const value_type &alpha,
+    const value_type &beta,
+    const value_type &reduction)
 {
-    ValidMoveSet vms(m_wpMoveSet, spBoard);
-    value_type score = m_evaluator.Score(spBoard, vms);
+    // A reduced move which is no better than the best move so far is not worth
+    // searching to the full depth
+    if (reduction > 0)
+    {
+        m_spSearchStats->m_reductions.fetch_add(1, std::memory_order_relaxed);
 
-    if (reachedEndState(depth, score))
+        value_type value = -negamax(board, depth - reduction, ply, -alpha - 1, -alpha);
+
+        if ((value <= alpha) || wasSearchStopped())
+        {
+            return value;
+        }
+
+        m_spSearchStats->m_reSearches.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // A window which is already zero-width cannot be narrowed further
+    if ((beta - alpha) > 1)
     {
-        return score;
+        // Prove the move is no better than the best move so far, which is
+        // cheaper than finding its exact score
+        value_type value = -negamax(board, depth, ply, -alpha - 1, -alpha);
+
+        if ((value <= alpha) || (value >= beta) || wasSearchStopped())
+        {
+            return value;
+        }
     }
 
-    MoveList moves = vms.GetMyValidMoves();
-    value_type v = s_posInfinity;
+    return -negamax(board, depth, ply, -beta, -alpha);
+}
 
-    for (auto it = moves.begin(); it != moves.end(); ++it)
+//==================================================================================================
+value_type MoveSelector::quiesce(
+    BitBoard &board,
+    const value_type &ply,
+    value_type alpha,
+    const value_type &beta)
+{
+    // The result of an abandoned search is discarded, so any value will do
+    if (isSearchStopped())
+    {
+        return 0;
+    }
+
+    SearchFrame &frame = (*m_spSearchStack)[ply];
+
+    const bool inCheck = isInCheck(board);
+    value_type v = s_negInfinity;
+    bool gameOver = false;
+
+    // A player in check may not stand pat, since the check may be mate, so
+    // every move out of check is searched instead
+    if (inCheck && (ply < s_maxSearchPly))
     {
-        std::shared_ptr<BitBoard> spResult = result(spBoard, *it);
-        v = std::min(v, maxValue(spResult, depth - 1, alpha, beta));
+        frame.m_validMoves.GenerateEvasions(board);
 
-        if (score <= alpha)
+        if (frame.m_validMoves.GetMyValidMoves().empty())
+        {
+            return evaluate(board, frame.m_validMoves, gameOver);
+        }
+    }
+    else
+    {
+        frame.m_staticScore = evaluate(board, frame.m_validMoves, gameOver);
+
+        if (gameOver || (ply >= s_maxSearchPly))
+        {
+            return frame.m_staticScore;
+        }
+
+        // Otherwise, the player may stand pat rather than capture
+        v = frame.m_staticScore;
+
+        if (v >= beta)
         {
             return v;
         }
 
-        beta = std::min(beta, v);
+        alpha = std::max(alpha, v);
+        frame.m_validMoves.GenerateCaptures(board);
+    }
+
+    // Captures which lose material are not searched, unless escaping check
+    MovePicker picker(board, frame.m_validMoves, frame.m_moves, *m_spMoveHistory, !inCheck);
+    Move move;
+
+    while (picker.Next(move))
+    {
+        // Skip captures which cannot raise the score to the window, even if the
+        // captured piece is won for free
+        if (!inCheck && move.IsCapture())
+        {
+            const value_type gain =
+                Evaluator::GetPieceValue(board.GetCapturedPiece(move)) + s_deltaMargin;
+
+            if ((frame.m_staticScore + gain) <= alpha)
+            {
+                continue;
+            }
+        }
+
+        board.MakeMove(move);
+        value_type value = -quiesce(board, ply + 1, -beta, -alpha);
+        board.UnmakeMove();
+
+        if (wasSearchStopped())
+        {
+            return 0;
+        }
+
+        v = std::max(v, value);
+
+        if (v >= beta)
+        {
+            break;
+        }
+
+        alpha = std::max(alpha, v);
     }
 
     return v;
 }
 
 //==================================================================================================
-std::shared_ptr<BitBoard>
-MoveSelector::result(const std::shared_ptr<BitBoard> &spBoard, Move move) const
+void MoveSelector::storeCutoff(
+    const BitBoard &board,
+    const value_type &depth,
+    const value_type &ply,
+    const Move &move)
+{
+    // Captures are already searched early, so only quiet moves are recorded
+    if (move.IsCapture())
+    {
+        return;
+    }
+
+    std::array<PackedMove, 2> &killers = (*m_spSearchStack)[ply].m_killers;
+    const PackedMove killer(move);
+
+    if (!(killers[0] == killer))
+    {
+        killers[1] = killers[0];
+        killers[0] = killer;
+    }
+
+    const Move &previous = (*m_spSearchStack)[ply - 1].m_currentMove;
+    m_spMoveHistory->Update(board.GetPlayerInTurn(), move, previous, depth);
+}
+
+//==================================================================================================
+value_type MoveSelector::lateMoveReduction(
+    const Move &move,
+    const value_type &depth,
+    const MoveList::size_type &moveNumber,
+    bool inCheck) const
+{
+    if ((depth < s_minReductionDepth) || (moveNumber <= s_minReductionMoves) || inCheck ||
+        !isQuiet(move))
+    {
+        return 0;
+    }
+
+    const value_type reduction = m_spSearchParameters->GetReduction(depth - 1, moveNumber);
+
+    // The reduced search must still reach the quiescence search
+    return std::min<value_type>(reduction, depth - 2);
+}
+
+//==================================================================================================
+bool MoveSelector::isQuiet(const Move &move) const
+{
+    return (!move.IsCapture() && !move.IsCheck() && (move.GetPromotionPiece() <= PAWN));
+}
+
+//==================================================================================================
+bool MoveSelector::isInCheck(const BitBoard &board) const
+{
+    return ((board.GetPlayerInTurn() == WHITE) ? board.IsWhiteInCheck() : board.IsBlackInCheck());
+}
+
+//==================================================================================================
+bool MoveSelector::canNullMove(
+    const BitBoard &board,
+    const value_type &depth,
+    const value_type &ply) const
+{
+    if (m_spSearchParameters->IsExhaustive() || (depth < s_nullMoveMinDepth) ||
+        (ply < m_nullMoveMinPly) || isInCheck(board))
+    {
+        return false;
+    }
+
+    // Two null moves in a row would only search the same position shallower
+    if ((*m_spSearchStack)[ply - 1].m_currentMove.GetMovingPiece() < PAWN)
+    {
+        return false;
+    }
+
+    // With only pawns, zugzwang is common enough that passing is often better
+    // than any legal move
+    const board_type pieces = board.GetColorPieces(board.GetPlayerInTurn()) &
+        ~(board.GetPieces(PAWN) | board.GetPieces(KING));
+
+    return (pieces != 0);
+}
+
+//==================================================================================================
+bool MoveSelector::needsNullMoveVerification(const BitBoard &board) const
 {
-    BitBoard copy(*spBoard);
-    copy.MakeMove(move);
+    const board_type pieces = board.GetColorPieces(board.GetPlayerInTurn()) &
+        ~(board.GetPieces(PAWN) | board.GetPieces(KING));
 
-    return std::make_shared<BitBoard>(copy);
+    return (std::popcount(pieces) <= s_nullMoveVerifyPieces);
 }
 
 //==================================================================================================
-bool MoveSelector::reachedEndState(const value_type &depth, const value_type &score) const
+value_type MoveSelector::nullMoveReduction(const value_type &depth) const
 {
-    return ((depth <= 1) || (score == s_posInfinity) || (score == s_negInfinity) || (score == 0));
+    return s_nullMoveReduction + ((depth >= s_nullMoveDeepDepth) ? 1 : 0);
+}
+
+//==================================================================================================
+value_type MoveSelector::evaluate(
+    BitBoard &board,
+    ValidMoveSet &validMoves,
+    bool &gameOver) const
+{
+    int score = 0;
+    gameOver = false;
+
+    // A draw by the fifty move rule or by repetition depends on the game's
+    // history, which the position's hash key does not cover
+    if (board.IsStalemateViaFiftyMoves() || board.IsStalemateViaRepetition())
+    {
+        score = m_evaluator.Score(board, validMoves.HasLegalMoves(board), *m_spPawnHashTable);
+        gameOver = true;
+    }
+    else
+    {
+        const hash_type key = EvaluationCache::GetKey(board);
+
+        if (m_spEvaluationCache->Probe(key, score))
+        {
+            m_spSearchStats->m_evaluationCacheHits.fetch_add(1, std::memory_order_relaxed);
+            Evaluator::UpdateGamePhase(board);
+        }
+        else
+        {
+            m_spSearchStats->m_evaluationCacheMisses.fetch_add(1, std::memory_order_relaxed);
+
+            const bool hasLegalMoves = validMoves.HasLegalMoves(board);
+            score = m_evaluator.Score(board, hasLegalMoves, *m_spPawnHashTable);
+
+            // Checkmate and stalemate are not cached, so that a cached score
+            // is never mistaken for the end of the game
+            if (hasLegalMoves)
+            {
+                m_spEvaluationCache->Store(key, score);
+            }
+            else
+            {
+                gameOver = true;
+            }
+        }
+    }
+
+    return static_cast<value_type>((board.GetPlayerInTurn() == m_engineColor) ? score : -score);
+}
+
+//==================================================================================================
+bool MoveSelector::isSearchStopped()
+{
+    if (wasSearchStopped())
+    {
+        return true;
+    }
+
+    ++m_nodeCount;
+
+    if (m_hasDeadline && ((m_nodeCount % s_nodesPerTimeCheck) == 0) &&
+        (std::chrono::steady_clock::now() >= m_deadline))
+    {
+        m_spStopSearch->store(true, std::memory_order_relaxed);
+        return true;
+    }
+
+    return false;
+}
+
+//==================================================================================================
+bool MoveSelector::wasSearchStopped() const
+{
+    return m_spStopSearch->load(std::memory_order_relaxed);
+}
+
+//==================================================================================================
+bool MoveSelector::isTranspositionCutoff(
+    const TranspositionTable::Entry &entry,
+    const value_type &depth,
+    const value_type &alpha,
+    const value_type &beta) const
+{
+    // A score stored from another path, or from a deeper search, may differ
+    // from the score this node would be searched to
+    if (m_spSearchParameters->IsExhaustive() || (entry.m_depth < depth))
+    {
+        return false;
+    }
+
+    switch (entry.m_bound)
+    {
+        case TranspositionTable::EXACT:
+            return true;
+        case TranspositionTable::LOWER:
+            return (entry.m_score >= beta);
+        case TranspositionTable::UPPER:
+            return (entry.m_score <= alpha);
+    }
+
+    return false;
+}
+
+//==================================================================================================
+void MoveSelector::orderMoves(MoveList &moves, const PackedMove &packedMove) const
+{
+    if (packedMove.IsNull())
+    {
+        return;
+    }
+
+    auto it = std::find_if(moves.begin(), moves.end(), [&packedMove](const Move &move) {
+        return (PackedMove(move) == packedMove);
+    });
+
+    if (it != moves.end())
+    {
+        std::rotate(moves.begin(), it, it + 1);
+    }
 }
 
 } // namespace chessmate
@@ -1,18 +1,103 @@
 #pragma once
 
+#include "engine/evaluation_cache.h"
 #include "engine/evaluator.h"
+#include "engine/move_history.h"
+#include "engine/pawn_hash_table.h"
+#include "engine/search_parameters.h"
+#include "engine/search_stats.h"
+#include "engine/split_point.h"
+#include "engine/transposition_table.h"
 #include "game/bit_board.h"
 #include "game/board_types.h"
 #include "movement/move.h"
 #include "movement/move_set.h"
+#include "movement/packed_move.h"
+#include "movement/valid_move_set.h"
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <vector>
+
+namespace fly::task {
+class ParallelTaskRunner;
+} // namespace fly::task
 
 namespace chessmate {
 
 /**
  * Class to select a move for the engine to play. Implements a depth-limited
- * min-max algorithm with alpha-beta pruning.
+ * negamax algorithm with fail-soft alpha-beta pruning: every node is scored
+ * from the perspective of its player in turn, and may return a score outside
+ * of its window as a tighter bound on its value. Search results are cached in a
+ * transposition table, which is used both to cut off searches of positions
+ * already searched deeply enough, and to search their best move first.
+ *
+ * Searches are iteratively deepened: the position is searched to depth 1, then
+ * 2, and so on up to the max depth. Each iteration is bounded by a wall-clock
+ * budget, and a search which runs out of time falls back to the best move of
+ * the last iteration which completed. Each iteration after the first starts
+ * with an aspiration window around the previous iteration's score, which is
+ * widened and searched again if the score falls outside of it.
+ *
+ * Nodes are searched with principal variation search: the first move of a node
+ * is searched with the full window, and the rest with a zero window, which only
+ * proves that they are no better. A move which turns out to be better is
+ * searched again with the full window.
+ *
+ * A search may use multiple threads (Lazy SMP). Helper threads are posted to
+ * the task runner, and each searches the same root position independently,
+ * with a slightly different depth and root move order. The helpers share the
+ * transposition table with the main thread, so their results steer and cut
+ * off the main thread's search. Only the main thread's result is reported, and
+ * the helpers are stopped and waited on once it completes.
+ *
+ * Alternatively, a search may use the Young Brothers Wait Concept (YBWC). Only
+ * the main thread searches the root. After the first move of a deep enough node
+ * has been searched, the node's remaining moves become a split point in the
+ * searching thread's queue, and idle helper threads steal moves from the split
+ * points of other threads. A thread whose split point is waiting on helpers to
+ * finish the last moves they took helps them with the split points they create
+ * beneath it, rather than idling.
+ *
+ * Each searching thread owns a preallocated search stack, with one frame per
+ * ply holding that node's generated moves and static score. Moves are made and
+ * unmade on a single board, so searching a node does not allocate. Each thread
+ * also owns a pawn hash table, so that positions sharing a pawn structure only
+ * have it evaluated once, and an evaluation cache of static scores, so that
+ * positions reached again are not scored again.
+ *
+ * Once the search reaches its max depth, a quiescence search continues with
+ * only captures (or, when in check, every move out of check) until the position
+ * is quiet, so that the static score is never taken in the middle of an
+ * exchange. Either side may instead stand pat on the static score. Captures
+ * which lose material per static exchange evaluation are pruned, as are those
+ * which cannot raise the score to the window even by winning the captured
+ * piece for free (delta pruning).
+ *
+ * Nodes are pruned by null moves: if the player in turn passes and the search
+ * of the resulting position to a reduced depth still fails high, then some
+ * real move almost certainly would too. Null moves are
+ * not tried when in check, with only pawns (where zugzwang is common), or
+ * right after another null move. With little material left, a null move
+ * cutoff is only trusted once verified by a reduced search of the node.
+ *
+ * Quiet moves searched late at a node are searched to a reduced depth first,
+ * and again to the full depth only if they turn out to be better than the best
+ * move so far (late move reductions). Near the max depth, quiet moves are
+ * skipped if the static score is too far outside of the window for them to
+ * matter (futility pruning), and nodes whose static score is far outside of the
+ * window are only searched by the quiescence search (razoring). The reductions
+ * and margins are given by the search parameters.
+ *
+ * Moves are handed out by a staged move picker: the transposition table's best
+ * move, then good captures, then killer moves (quiet moves which caused a
+ * cutoff at the same ply) and the countermove to the previous move, then the
+ * remaining quiet moves by their history scores, and finally bad captures. The
+ * killer moves, history scores, and countermoves are kept per thread.
  *
  * @author Timothy Flynn
  * @version March 3, 2013
@@ -20,80 +105,427 @@ namespace chessmate {
 class MoveSelector
 {
 public:
+    /**
+     * Enumerated list of ways to search with multiple threads.
+     */
+    enum ParallelMode
+    {
+        LAZY_SMP,
+        YOUNG_BROTHERS_WAIT
+    };
+
     /**
      * Constructor.
      *
      * @param std::shared_ptr<MoveSet> The list of possible moves.
      * @param std::shared_ptr<BitBoard> Shared pointer to the game's board.
+     * @param std::shared_ptr<TranspositionTable> The game's transposition table.
+     * @param std::shared_ptr<SearchParameters> The reduction and pruning parameters.
+     * @param size_t The size of each search thread's evaluation cache, in megabytes.
+     * @param std::shared_ptr<ParallelTaskRunner> Task runner to post helper searches to.
+     * @param unsigned The number of threads to search with, including the main thread.
+     * @param ParallelMode How to search with multiple threads.
      * @param color_type The engine color.
      */
     MoveSelector(
         const std::shared_ptr<MoveSet> &,
         const std::shared_ptr<BitBoard> &,
+        const std::shared_ptr<TranspositionTable> &,
+        const std::shared_ptr<SearchParameters> &,
+        std::size_t,
+        const std::shared_ptr<fly::task::ParallelTaskRunner> &,
+        unsigned int,
+        ParallelMode,
         const color_type &);
 
     /**
-     * Use min-max to determine the best move that can be made.
+     * Search the game's board with iteratively deepened negamax to find the
+     * best move for the engine to make.
      *
      * @param value_type The max depth to search.
+     * @param milliseconds The time allowed for the search, or 0 for no limit.
      *
      * @return The best move.
      */
-    Move GetBestMove(const value_type &) const;
+    Move GetBestMove(const value_type &, const std::chrono::milliseconds &);
+
+    /**
+     * @return Score of the best move of the most recent search, from the
+     *         engine's perspective.
+     */
+    value_type GetBestScore() const;
+
+    /**
+     * @return Split point statistics of the most recent YBWC search.
+     */
+    const SplitPointStats &GetSplitPointStats() const;
+
+    /**
+     * @return Reduction and pruning statistics of the most recent search.
+     */
+    const SearchStats &GetSearchStats() const;
 
 private:
     /**
-     * The algorithm to calculate the max value for the engine.
+     * Scratch space for searching a single node, allocated once so that the
+     * search itself does not allocate.
+     */
+    struct SearchFrame
+    {
+        SearchFrame();
+
+        ValidMoveSet m_validMoves;
+        MoveList m_moves;
+        value_type m_staticScore;
+        std::array<PackedMove, 2> m_killers;
+        Move m_currentMove;
+    };
+
+    /**
+     * Post a helper search for each thread other than the main thread.
      *
-     * @param std::shared_ptr<BitBoard> Shared pointer to the current depth's board.
+     * @param BitBoard The board to search.
      * @param value_type The max depth to search.
+     * @param milliseconds The time allowed for the search.
+     */
+    void startHelpers(const BitBoard &, const value_type &, const std::chrono::milliseconds &);
+
+    /**
+     * Wait for every helper search of the current search to return. The search
+     * must already be stopped.
+     */
+    void waitForHelpers() const;
+
+    /**
+     * Iteratively deepen a search of the root position.
+     *
+     * @param BitBoard The board to search.
+     * @param value_type The max depth to search.
+     * @param milliseconds The time allowed for the search.
+     *
+     * @return The best move of the last completed iteration.
+     */
+    Move searchRoot(BitBoard &, const value_type &, const std::chrono::milliseconds &);
+
+    /**
+     * Search each of the root's moves within a window.
+     *
+     * @param BitBoard The board to search.
+     * @param MoveList The root's moves.
+     * @param value_type The depth to search.
      * @param value_type The alpha value.
      * @param value_type The beta value.
+     * @param Move The best move, updated if any move is searched.
+     *
+     * @return The best score, which is a bound if outside of the window.
+     */
+    value_type searchRootMoves(
+        BitBoard &,
+        MoveList &,
+        const value_type &,
+        value_type,
+        const value_type &,
+        Move &);
+
+    /**
+     * Steal moves from the split points of other threads until the search is
+     * stopped. Run by the helper threads of a YBWC search.
+     */
+    void helpSplitPoints();
+
+    /**
+     * Steal a split point created by one of a set of threads, and search its
+     * moves along with the threads already searching it.
+     *
+     * @param uint64_t A mask of the indices of the threads to steal from.
+     * @param value_type The shallowest ply of a split point to steal.
+     *
+     * @return True if a split point was stolen and searched.
+     */
+    bool stealSplitPoint(const std::uint64_t &, const value_type &);
+
+    /**
+     * Decide if a node should be split after searching its first move. A node
+     * which turns out to have no moves remaining is not split.
+     *
+     * @param value_type The depth of the node.
+     *
+     * @return True if the node should be split.
+     */
+    bool shouldSplit(const value_type &) const;
+
+    /**
+     * Turn the remaining moves of a node into a split point, and search them
+     * along with any helper threads which join the split point.
+     *
+     * @param BitBoard The board at the node.
+     * @param MoveList The moves remaining at the node.
+     * @param value_type The depth of the node.
+     * @param value_type The ply of the node.
+     * @param value_type The alpha value, updated with the split point's result.
+     * @param value_type The beta value.
+     * @param value_type The best score, updated with the split point's result.
+     * @param PackedMove The best move, updated with the split point's result.
+     *
+     * @return True if the split point was fully searched, false if the search
+     *         was stopped.
+     */
+    bool splitSearch(
+        BitBoard &,
+        MoveList,
+        const value_type &,
+        const value_type &,
+        value_type &,
+        const value_type &,
+        value_type &,
+        PackedMove &);
+
+    /**
+     * Take and search moves from a split point until none remain.
      *
-     * @return The max utility value.
+     * @param SplitPoint The split point to search.
+     * @param BitBoard A board at the split node.
+     * @param bool True if this thread created the split point.
      */
-    value_type
-    maxValue(const std::shared_ptr<BitBoard> &, const value_type &, value_type, value_type) const;
+    void searchSplitPoint(SplitPoint &, BitBoard &, bool);
 
     /**
-     * The algorithm to calculate the min value for the human.
+     * The negamax algorithm to calculate the value of a node for its player in
+     * turn.
      *
-     * @param std::shared_ptr<BitBoard> Shared pointer to the current depth's board.
+     * @param BitBoard The current depth's board.
      * @param value_type The max depth to search.
+     * @param value_type The number of moves made since the root.
      * @param value_type The alpha value.
      * @param value_type The beta value.
      *
-     * @return The min utility value.
+     * @return The node's value, which is a bound if outside of the window.
      */
-    value_type
-    minValue(const std::shared_ptr<BitBoard> &, const value_type &, value_type, value_type) const;
+    value_type negamax(
+        BitBoard &,
+        const value_type &,
+        const value_type &,
+        value_type,
+        const value_type &);
 
     /**
-     * Create a copy of the given board, and make the given move on that copy.
-     * Note: only promotes to queens for now.
+     * Search a move which is not the first of its node with a zero window, and
+     * again with the full window if it turns out to be better than the best
+     * move so far. A reduced move is first searched to the reduced depth, and
+     * only searched to the full depth if it is better. The move must already
+     * be made on the board.
      *
-     * @param std::shared_ptr<BitBoard> Shared pointer to the current depth's board.
-     * @param Move The move to make on the board copy.
+     * @param BitBoard The board after the move.
+     * @param value_type The depth of the move's child node.
+     * @param value_type The ply of the move's child node.
+     * @param value_type The alpha value of the move's node.
+     * @param value_type The beta value of the move's node.
+     * @param value_type The depth by which to reduce the move, if any.
      *
-     * @return The created copy after the move was made.
+     * @return The move's score, for the player who made it.
      */
-    std::shared_ptr<BitBoard> result(const std::shared_ptr<BitBoard> &, Move) const;
+    value_type searchLaterMove(
+        BitBoard &,
+        const value_type &,
+        const value_type &,
+        const value_type &,
+        const value_type &,
+        const value_type &);
 
     /**
-     * Decide if the selector should stop searching.
+     * The quiescence search to calculate the value of a node for its player in
+     * turn, once the max depth has been reached.
+     *
+     * @param BitBoard The current depth's board.
+     * @param value_type The number of moves made since the root.
+     * @param value_type The alpha value.
+     * @param value_type The beta value.
      *
+     * @return The node's value, which is a bound if outside of the window.
+     */
+    value_type quiesce(BitBoard &, const value_type &, value_type, const value_type &);
+
+    /**
+     * Record a quiet move which caused a cutoff as a killer move of its ply,
+     * in the history table, and as the countermove to the previous move, so
+     * that other nodes try it early.
+     *
+     * @param BitBoard The board at the node.
+     * @param value_type The depth of the node.
+     * @param value_type The ply of the node.
+     * @param Move The move which caused the cutoff.
+     */
+    void storeCutoff(const BitBoard &, const value_type &, const value_type &, const Move &);
+
+    /**
+     * Get the depth by which to reduce a late move. The move must already be
+     * made on the board, so that it is known whether it gives check.
+     *
+     * @param Move The move to reduce.
+     * @param value_type The depth of the move's node.
+     * @param size_type The number of the move at its node, starting at 1.
+     * @param bool True if the player making the move was in check.
+     *
+     * @return The reduction, or 0 if the move should not be reduced.
+     */
+    value_type lateMoveReduction(
+        const Move &,
+        const value_type &,
+        const MoveList::size_type &,
+        bool) const;
+
+    /**
+     * Decide if a move is quiet: not a capture, a promotion, or a check. The
+     * move must already be made on the board.
+     *
+     * @param Move The move to check.
+     *
+     * @return True if the move is quiet.
+     */
+    bool isQuiet(const Move &) const;
+
+    /**
+     * Decide if the player in turn is in check.
+     *
+     * @param BitBoard The board to check.
+     *
+     * @return True if the player in turn is in check.
+     */
+    bool isInCheck(const BitBoard &) const;
+
+    /**
+     * Decide if a null move may be tried at a node.
+     *
+     * @param BitBoard The board at the node.
+     * @param value_type The depth of the node.
+     * @param value_type The ply of the node.
+     *
+     * @return True if the null move may be tried.
+     */
+    bool canNullMove(const BitBoard &, const value_type &, const value_type &) const;
+
+    /**
+     * Decide if a null move cutoff must be verified, because the player in turn
+     * has little material left and so may be in zugzwang.
+     *
+     * @param BitBoard The board at the node.
+     *
+     * @return True if the cutoff must be verified.
+     */
+    bool needsNullMoveVerification(const BitBoard &) const;
+
+    /**
+     * Get the depth by which a null move's search is reduced.
+     *
+     * @param value_type The depth of the node.
+     *
+     * @return The reduction.
+     */
+    value_type nullMoveReduction(const value_type &) const;
+
+    /**
+     * Score a position from the perspective of its player in turn, and decide
+     * if the game is over there. Scores are looked up in, and stored to, this
+     * thread's evaluation cache, unless the position is drawn by its history.
+     * Only a position which is not cached is checked for any legal moves, to
+     * detect checkmate and stalemate, so those positions are never cached.
+     *
+     * @param BitBoard The board to score.
+     * @param ValidMoveSet The set to check for legal moves with.
+     * @param bool Set to true if the game is over, false otherwise.
+     *
+     * @return The position's static score.
+     */
+    value_type evaluate(BitBoard &, ValidMoveSet &, bool &) const;
+
+    /**
+     * Count a searched node, and periodically check whether the search has run
+     * out of time.
+     *
+     * @return True if the search should be abandoned.
+     */
+    bool isSearchStopped();
+
+    /**
+     * @return True if the search has been stopped, without counting a node.
+     */
+    bool wasSearchStopped() const;
+
+    /**
+     * Decide if a transposition table entry is deep enough, and has a score
+     * precise enough, to be used in place of searching its position.
+     *
+     * @param TranspositionTable::Entry The entry for the position.
      * @param value_type The current depth.
-     * @param value_type The current score.
+     * @param value_type The alpha value.
+     * @param value_type The beta value.
+     *
+     * @return True if the entry's score may be used.
+     */
+    bool isTranspositionCutoff(
+        const TranspositionTable::Entry &,
+        const value_type &,
+        const value_type &,
+        const value_type &) const;
+
+    /**
+     * Move the transposition table's best move, if any, to the front of the
+     * root's moves so that it is searched first.
      *
-     * @return True if the selector should stop searching.
+     * @param MoveList The moves to order.
+     * @param PackedMove The best move.
      */
-    bool reachedEndState(const value_type &, const value_type &) const;
+    void orderMoves(MoveList &, const PackedMove &) const;
 
-    std::weak_ptr<MoveSet> m_wpMoveSet;
+    std::shared_ptr<MoveSet> m_spMoveSet;
     std::weak_ptr<BitBoard> m_wpBoard;
+    std::shared_ptr<TranspositionTable> m_spTranspositionTable;
+    std::shared_ptr<SearchParameters> m_spSearchParameters;
+    std::size_t m_evaluationCacheSize;
+    std::shared_ptr<fly::task::ParallelTaskRunner> m_spTaskRunner;
     color_type m_engineColor;
 
     Evaluator m_evaluator;
+
+    // Number of threads to search with, and this thread's index (0 for the
+    // main thread)
+    unsigned int m_searchThreads;
+    unsigned int m_threadIndex;
+    ParallelMode m_parallelMode;
+
+    // Split point queues of each thread of the current YBWC search, and their
+    // statistics
+    std::shared_ptr<std::vector<SplitPointQueue>> m_spSplitPointQueues;
+    std::shared_ptr<SplitPointStats> m_spSplitPointStats;
+
+    // Reduction, pruning, and evaluation cache statistics of the current search,
+    // shared by all of its threads
+    std::shared_ptr<SearchStats> m_spSearchStats;
+
+    // This thread's search stack, indexed by ply, its history of quiet moves
+    // which caused cutoffs, and its caches of evaluated pawn structures and
+    // positions
+    std::shared_ptr<std::vector<SearchFrame>> m_spSearchStack;
+    std::shared_ptr<MoveHistory> m_spMoveHistory;
+    std::shared_ptr<PawnHashTable> m_spPawnHashTable;
+    std::shared_ptr<EvaluationCache> m_spEvaluationCache;
+
+    // Time control of the current search. The stop flag is shared with the
+    // current search's helper threads.
+    std::chrono::steady_clock::time_point m_deadline;
+    bool m_hasDeadline;
+    std::shared_ptr<std::atomic_bool> m_spStopSearch;
+    std::uint64_t m_nodeCount;
+
+    // Number of the current search's helper threads which have not returned
+    std::shared_ptr<std::atomic<unsigned int>> m_spRunningHelpers;
+
+    // Score of the best move of this thread's last completed iteration
+    value_type m_bestScore;
+
+    // Shallowest ply at which null moves may be tried, raised while verifying a
+    // null move cutoff
+    value_type m_nullMoveMinPly;
 };
 
 } // namespace chessmate
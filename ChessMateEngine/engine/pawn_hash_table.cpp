@@ -0,0 +1,42 @@
+#include "pawn_hash_table.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace chessmate {
+
+//==================================================================================================
+PawnHashTable::PawnHashTable(std::size_t size)
+{
+    std::size_t count = std::bit_floor(std::max<std::size_t>(size, 1));
+
+    // Slots are value-initialized to a key of zero and an empty entry, which
+    // is also the correct entry for a board without any pawns
+    m_slots = std::vector<Slot>(count);
+    m_slotMask = count - 1;
+}
+
+//==================================================================================================
+bool PawnHashTable::Probe(const hash_type &key, Entry &entry) const
+{
+    const Slot &slot = m_slots[key & m_slotMask];
+
+    if (slot.m_key == key)
+    {
+        entry = slot.m_entry;
+        return true;
+    }
+
+    return false;
+}
+
+//==================================================================================================
+void PawnHashTable::Store(const hash_type &key, const Entry &entry)
+{
+    Slot &slot = m_slots[key & m_slotMask];
+
+    slot.m_key = key;
+    slot.m_entry = entry;
+}
+
+} // namespace chessmate
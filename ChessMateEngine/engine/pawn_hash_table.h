@@ -0,0 +1,78 @@
+#pragma once
+
+#include "game/board_types.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace chessmate {
+
+/**
+ * Class to cache the evaluation of pawn structures, keyed by the positions'
+ * pawn hash keys. Pawns move rarely compared to other pieces, so most positions
+ * reached during a search share their pawn structure with one already scored.
+ *
+ * Each key maps to a single entry, which is always replaced by the most recent
+ * structure stored there. The table is not thread-safe; each search thread owns
+ * its own.
+ *
+ * @author Timothy Flynn (trflynn89@gmail.com)
+ * @version October 17, 2026
+ */
+class PawnHashTable
+{
+public:
+    /**
+     * The data stored for a single pawn structure.
+     */
+    struct Entry
+    {
+        // Score of the structure, positive if it favors white
+        int m_score;
+
+        // Squares attacked by each player's pawns, indexed by color
+        std::array<board_type, NONE> m_attacks;
+    };
+
+    /**
+     * Constructor. Creates an empty table.
+     *
+     * @param size_t The number of entries in the table, rounded down to a power
+     *        of two.
+     */
+    explicit PawnHashTable(std::size_t);
+
+    /**
+     * Look up a pawn structure in the table.
+     *
+     * @param hash_type The structure's pawn hash key.
+     * @param Entry The entry to fill if the structure is found.
+     *
+     * @return True if the structure was found.
+     */
+    bool Probe(const hash_type &, Entry &) const;
+
+    /**
+     * Store a pawn structure in the table.
+     *
+     * @param hash_type The structure's pawn hash key.
+     * @param Entry The entry to store.
+     */
+    void Store(const hash_type &, const Entry &);
+
+private:
+    /**
+     * A single entry, as stored in the table.
+     */
+    struct Slot
+    {
+        hash_type m_key;
+        Entry m_entry;
+    };
+
+    std::vector<Slot> m_slots;
+    hash_type m_slotMask;
+};
+
+} // namespace chessmate
@@ -0,0 +1,99 @@
+#include "search_parameters.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace chessmate {
+
+namespace {
+
+    // Deepest nodes at which futility pruning and razoring are tried
+    const value_type s_maxFutilityDepth = 3;
+    const value_type s_maxRazorDepth = 2;
+
+} // namespace
+
+//==================================================================================================
+SearchParameters::SearchParameters() : SearchParameters(0.0, 1.0, 0, 0)
+{
+    // No late move is reduced, and no node is pruned or razored
+    for (auto &reductions : m_reductions)
+    {
+        reductions.fill(0);
+    }
+
+    m_exhaustive = true;
+}
+
+//==================================================================================================
+SearchParameters::SearchParameters(
+    double reductionBase,
+    double reductionDivisor,
+    value_type futilityMargin,
+    value_type razorMargin) :
+    m_futilityMargin(futilityMargin),
+    m_razorMargin(razorMargin),
+    m_exhaustive(false)
+{
+    reductionDivisor = std::max(reductionDivisor, 1.0);
+
+    for (std::size_t depth = 0; depth < s_reductionDepths; ++depth)
+    {
+        for (std::size_t moveNumber = 0; moveNumber < s_reductionMoves; ++moveNumber)
+        {
+            double reduction = 0.0;
+
+            if ((depth > 0) && (moveNumber > 0))
+            {
+                const double depthLog = std::log(static_cast<double>(depth));
+                const double moveLog = std::log(static_cast<double>(moveNumber));
+
+                reduction = reductionBase + ((depthLog * moveLog) / reductionDivisor);
+            }
+
+            m_reductions[depth][moveNumber] = static_cast<value_type>(std::max(reduction, 0.0));
+        }
+    }
+}
+
+//==================================================================================================
+value_type SearchParameters::GetReduction(
+    const value_type &depth,
+    const std::size_t &moveNumber) const
+{
+    const value_type maxDepth = static_cast<value_type>(s_reductionDepths - 1);
+    const auto depthIndex = static_cast<std::size_t>(std::clamp<value_type>(depth, 0, maxDepth));
+    const std::size_t moveIndex = std::min(moveNumber, s_reductionMoves - 1);
+
+    return m_reductions[depthIndex][moveIndex];
+}
+
+//==================================================================================================
+value_type SearchParameters::GetFutilityMargin(const value_type &depth) const
+{
+    if ((depth < 1) || (depth > s_maxFutilityDepth))
+    {
+        return 0;
+    }
+
+    return static_cast<value_type>(m_futilityMargin * depth);
+}
+
+//==================================================================================================
+value_type SearchParameters::GetRazorMargin(const value_type &depth) const
+{
+    if ((depth < 1) || (depth > s_maxRazorDepth))
+    {
+        return 0;
+    }
+
+    return static_cast<value_type>(m_razorMargin * depth);
+}
+
+//==================================================================================================
+bool SearchParameters::IsExhaustive() const
+{
+    return m_exhaustive;
+}
+
+} // namespace chessmate
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "game/board_types.h"
+
+#include <array>
+#include <cstddef>
+
+namespace chessmate {
+
+/**
+ * Class to hold the tunable parameters of the search's reductions and pruning:
+ *
+ * - Late move reductions: quiet moves searched late at a node are searched to
+ *   a reduced depth first. The reduction grows with both the depth of the node
+ *   and the number of moves already searched there, per a table computed from
+ *   a base and a divisor: base + ln(depth) * ln(moveNumber) / divisor.
+ * - Futility pruning: near the max depth, quiet moves are skipped if the static
+ *   score is so far below the window that a margin (per remaining ply) would
+ *   not raise it to the window.
+ * - Razoring: just above the max depth, nodes whose static score is far below
+ *   the window are only searched by the quiescence search.
+ *
+ * Depths are counted in plies remaining before the quiescence search.
+ *
+ * Parameters may also describe an exhaustive search, which searches every move
+ * to the full depth, scores the nodes at the full depth as they stand rather
+ * than searching their captures, and trusts no score it did not search itself.
+ * Its score is the exact minimax score of the position, which the search is
+ * validated against.
+ *
+ * @author Timothy Flynn (trflynn89@gmail.com)
+ * @version October 17, 2026
+ */
+class SearchParameters
+{
+public:
+    /**
+     * Constructor. Creates the parameters of an exhaustive search.
+     */
+    SearchParameters();
+
+    /**
+     * Constructor.
+     *
+     * @param double The base of the late move reduction table.
+     * @param double The divisor of the late move reduction table.
+     * @param value_type The futility margin per remaining ply.
+     * @param value_type The razoring margin per remaining ply.
+     */
+    SearchParameters(double, double, value_type, value_type);
+
+    /**
+     * Get the depth by which to reduce a late move.
+     *
+     * @param value_type The depth remaining at the move's node.
+     * @param size_t The number of the move at its node, starting at 1.
+     *
+     * @return The reduction, or 0 if the move should not be reduced.
+     */
+    value_type GetReduction(const value_type &, const std::size_t &) const;
+
+    /**
+     * Get the futility margin of a node.
+     *
+     * @param value_type The depth remaining at the node.
+     *
+     * @return The margin, or 0 if the node is too deep to prune.
+     */
+    value_type GetFutilityMargin(const value_type &) const;
+
+    /**
+     * Get the razoring margin of a node.
+     *
+     * @param value_type The depth remaining at the node.
+     *
+     * @return The margin, or 0 if the node is too deep to razor.
+     */
+    value_type GetRazorMargin(const value_type &) const;
+
+    /**
+     * @return True if the search may not reduce or prune any move, search any
+     *         node beyond the max depth, nor cut off any node with a
+     *         transposition table score.
+     */
+    bool IsExhaustive() const;
+
+private:
+    static constexpr std::size_t s_reductionDepths = 64;
+    static constexpr std::size_t s_reductionMoves = 64;
+
+    std::array<std::array<value_type, s_reductionMoves>, s_reductionDepths> m_reductions;
+
+    value_type m_futilityMargin;
+    value_type m_razorMargin;
+
+    bool m_exhaustive;
+};
+
+} // namespace chessmate
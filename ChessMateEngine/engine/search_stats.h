@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace chessmate {
+
+/**
+ * Counters describing the size, reductions, pruning, and evaluation caching of
+ * a search, shared by all of the search's threads.
+ */
+struct SearchStats
+{
+    // Number of nodes searched by every thread, over every iteration
+    std::atomic<std::uint64_t> m_nodes;
+
+    // Number of late moves searched to a reduced depth
+    std::atomic<std::uint64_t> m_reductions;
+
+    // Number of reduced moves which failed high, and were searched again to the
+    // full depth
+    std::atomic<std::uint64_t> m_reSearches;
+
+    // Number of quiet moves skipped by futility pruning
+    std::atomic<std::uint64_t> m_futilityPrunes;
+
+    // Number of nodes razored into a quiescence search
+    std::atomic<std::uint64_t> m_razorPrunes;
+
+    // Number of static scores found in, and missing from, the evaluation caches
+    std::atomic<std::uint64_t> m_evaluationCacheHits;
+    std::atomic<std::uint64_t> m_evaluationCacheMisses;
+};
+
+} // namespace chessmate
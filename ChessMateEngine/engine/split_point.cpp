@@ -0,0 +1,181 @@
+#include "split_point.h"
+
+#include <fly/types/numeric/literals.hpp>
+
+#include <algorithm>
+#include <utility>
+
+using namespace fly::literals::numeric_literals;
+
+namespace chessmate {
+
+//==================================================================================================
+SplitPoint::SplitPoint(
+    const BitBoard &board,
+    MoveList moves,
+    const value_type &depth,
+    const value_type &ply,
+    const value_type &alpha,
+    const value_type &beta,
+    const value_type &bestValue,
+    const PackedMove &bestMove) :
+    m_board(board),
+    m_moves(std::move(moves)),
+    m_depth(depth),
+    m_ply(ply),
+    m_nextMove(0),
+    m_alpha(alpha),
+    m_beta(beta),
+    m_bestValue(bestValue),
+    m_bestMove(bestMove),
+    m_cutoff(false),
+    m_activeThreads(0)
+{
+}
+
+//==================================================================================================
+const BitBoard &SplitPoint::GetBoard() const
+{
+    return m_board;
+}
+
+//==================================================================================================
+value_type SplitPoint::GetDepth() const
+{
+    return m_depth;
+}
+
+//==================================================================================================
+value_type SplitPoint::GetPly() const
+{
+    return m_ply;
+}
+
+//==================================================================================================
+bool SplitPoint::GetNextMove(
+    Move &move,
+    value_type &alpha,
+    value_type &beta,
+    MoveList::size_type &index)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_cutoff || (m_nextMove >= m_moves.size()))
+    {
+        return false;
+    }
+
+    index = m_nextMove;
+    move = m_moves[m_nextMove++];
+    alpha = m_alpha;
+    beta = m_beta;
+
+    return true;
+}
+
+//==================================================================================================
+bool SplitPoint::Update(const Move &move, const value_type &value)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (value > m_bestValue)
+    {
+        m_bestValue = value;
+        m_bestMove = PackedMove(move);
+    }
+
+    m_alpha = std::max(m_alpha, m_bestValue);
+
+    // Once the window closes, the remaining moves cannot change the result
+    if (!m_cutoff && (m_alpha >= m_beta) && (m_nextMove < m_moves.size()))
+    {
+        m_cutoff = true;
+        return true;
+    }
+
+    return false;
+}
+
+//==================================================================================================
+bool SplitPoint::HasMoves() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (!m_cutoff && (m_nextMove < m_moves.size()));
+}
+
+//==================================================================================================
+void SplitPoint::Join(unsigned int thread)
+{
+    m_activeThreads.fetch_or(1_u64 << thread, std::memory_order_acq_rel);
+}
+
+//==================================================================================================
+void SplitPoint::Leave(unsigned int thread)
+{
+    m_activeThreads.fetch_and(~(1_u64 << thread), std::memory_order_acq_rel);
+}
+
+//==================================================================================================
+std::uint64_t SplitPoint::GetActiveThreads() const
+{
+    return m_activeThreads.load(std::memory_order_acquire);
+}
+
+//==================================================================================================
+bool SplitPoint::IsIdle() const
+{
+    return (m_activeThreads.load(std::memory_order_acquire) == 0);
+}
+
+//==================================================================================================
+bool SplitPoint::IsCutoff() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cutoff;
+}
+
+//==================================================================================================
+value_type SplitPoint::GetBestValue() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bestValue;
+}
+
+//==================================================================================================
+PackedMove SplitPoint::GetBestMove() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bestMove;
+}
+
+//==================================================================================================
+void SplitPointQueue::Push(const std::shared_ptr<SplitPoint> &spSplitPoint)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_splitPoints.push_back(spSplitPoint);
+}
+
+//==================================================================================================
+void SplitPointQueue::Pop()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_splitPoints.pop_back();
+}
+
+//==================================================================================================
+std::shared_ptr<SplitPoint> SplitPointQueue::Steal(const value_type &minPly) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (const auto &spSplitPoint : m_splitPoints)
+    {
+        if ((spSplitPoint->GetPly() >= minPly) && spSplitPoint->HasMoves())
+        {
+            return spSplitPoint;
+        }
+    }
+
+    return nullptr;
+}
+
+} // namespace chessmate
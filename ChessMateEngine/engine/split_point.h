@@ -0,0 +1,219 @@
+#pragma once
+
+#include "game/bit_board.h"
+#include "game/board_types.h"
+#include "movement/move.h"
+#include "movement/move_set.h"
+#include "movement/packed_move.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace chessmate {
+
+/**
+ * Class to represent a node of a parallel search whose remaining moves may be
+ * searched by any thread. Per the Young Brothers Wait Concept, a node is only
+ * split after its first move (the eldest brother) has been searched serially,
+ * so that the node's window is already narrowed before its younger brothers
+ * are searched in parallel.
+ *
+ * Threads take moves from the split point one at a time, along with the current
+ * window, and report each move's score back. Once the window closes, the split
+ * point is cut off and no more moves are handed out.
+ *
+ * @author Timothy Flynn (trflynn89@gmail.com)
+ * @version October 17, 2026
+ */
+class SplitPoint
+{
+public:
+    /**
+     * Most threads which may search split points, as the threads searching a
+     * split point are tracked in a mask.
+     */
+    static constexpr unsigned int s_maxThreads = 64;
+
+    /**
+     * Constructor.
+     *
+     * @param BitBoard The board at the split node.
+     * @param MoveList The moves remaining to be searched.
+     * @param value_type The depth of the split node.
+     * @param value_type The ply of the split node.
+     * @param value_type The alpha value after searching the first move.
+     * @param value_type The beta value after searching the first move.
+     * @param value_type The best score after searching the first move.
+     * @param PackedMove The best move after searching the first move.
+     */
+    SplitPoint(
+        const BitBoard &,
+        MoveList,
+        const value_type &,
+        const value_type &,
+        const value_type &,
+        const value_type &,
+        const value_type &,
+        const PackedMove &);
+
+    /**
+     * @return The board at the split node.
+     */
+    const BitBoard &GetBoard() const;
+
+    /**
+     * @return The depth of the split node.
+     */
+    value_type GetDepth() const;
+
+    /**
+     * @return The ply of the split node.
+     */
+    value_type GetPly() const;
+
+    /**
+     * Take the next move to search.
+     *
+     * @param Move The move to fill.
+     * @param value_type The alpha value to search the move with.
+     * @param value_type The beta value to search the move with.
+     * @param size_type The index of the move among the split point's moves.
+     *
+     * @return True if a move was taken, false if none remain.
+     */
+    bool GetNextMove(Move &, value_type &, value_type &, MoveList::size_type &);
+
+    /**
+     * Record the score of a searched move.
+     *
+     * @param Move The searched move.
+     * @param value_type The move's score.
+     *
+     * @return True if the score cut off the split point.
+     */
+    bool Update(const Move &, const value_type &);
+
+    /**
+     * @return True if there are moves remaining to be taken.
+     */
+    bool HasMoves() const;
+
+    /**
+     * Register a thread as searching this split point.
+     *
+     * @param unsigned int The index of the thread.
+     */
+    void Join(unsigned int);
+
+    /**
+     * Unregister a thread from searching this split point.
+     *
+     * @param unsigned int The index of the thread.
+     */
+    void Leave(unsigned int);
+
+    /**
+     * @return A mask of the indices of the threads searching this split point.
+     */
+    std::uint64_t GetActiveThreads() const;
+
+    /**
+     * @return True if no threads are searching this split point.
+     */
+    bool IsIdle() const;
+
+    /**
+     * @return True if the split point was cut off.
+     */
+    bool IsCutoff() const;
+
+    /**
+     * @return The best score found at the split point.
+     */
+    value_type GetBestValue() const;
+
+    /**
+     * @return The packed best move found at the split point.
+     */
+    PackedMove GetBestMove() const;
+
+private:
+    const BitBoard m_board;
+    const MoveList m_moves;
+    const value_type m_depth;
+    const value_type m_ply;
+
+    mutable std::mutex m_mutex;
+
+    MoveList::size_type m_nextMove;
+    value_type m_alpha;
+    value_type m_beta;
+    value_type m_bestValue;
+    PackedMove m_bestMove;
+    bool m_cutoff;
+
+    std::atomic<std::uint64_t> m_activeThreads;
+};
+
+/**
+ * Class to hold the split points created by a single search thread. The owning
+ * thread pushes and pops its own split points at the back, and idle threads
+ * steal from the front, where the split points closest to the root (and thus
+ * with the most work remaining) are.
+ *
+ * @author Timothy Flynn (trflynn89@gmail.com)
+ * @version October 17, 2026
+ */
+class SplitPointQueue
+{
+public:
+    /**
+     * Add a split point created by the owning thread.
+     *
+     * @param std::shared_ptr<SplitPoint> The split point to add.
+     */
+    void Push(const std::shared_ptr<SplitPoint> &);
+
+    /**
+     * Remove the split point most recently added by the owning thread.
+     */
+    void Pop();
+
+    /**
+     * Find the oldest split point which still has moves to be taken, and is no
+     * shallower than a given ply.
+     *
+     * @param value_type The shallowest ply of a split point to find.
+     *
+     * @return The split point, or null if there are none.
+     */
+    std::shared_ptr<SplitPoint> Steal(const value_type &) const;
+
+private:
+    mutable std::mutex m_mutex;
+    std::deque<std::shared_ptr<SplitPoint>> m_splitPoints;
+};
+
+/**
+ * Counters describing the split points of a parallel search.
+ */
+struct SplitPointStats
+{
+    // Number of split points created
+    std::atomic<std::uint64_t> m_splitPoints;
+
+    // Number of times a thread joined a split point created by another thread
+    std::atomic<std::uint64_t> m_steals;
+
+    // Number of moves searched by threads other than the split point's creator
+    std::atomic<std::uint64_t> m_stolenMoves;
+
+    // Number of split points which were cut off with moves remaining
+    std::atomic<std::uint64_t> m_cutoffs;
+};
+
+} // namespace chessmate
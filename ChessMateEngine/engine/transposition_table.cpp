@@ -0,0 +1,130 @@
+#include "transposition_table.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace chessmate {
+
+namespace {
+
+    // Bit positions of each field of a packed entry
+    const unsigned int s_scoreShift = 16;
+    const unsigned int s_depthShift = 32;
+    const unsigned int s_boundShift = 40;
+    const unsigned int s_ageShift = 42;
+
+    // Searches are aged modulo the number of values the age field can hold
+    const std::uint8_t s_ageMask = 0x3f;
+
+    // Number of bytes in a megabyte
+    const std::size_t s_megabyte = 1 << 20;
+
+} // namespace
+
+//==================================================================================================
+TranspositionTable::TranspositionTable(std::size_t megabytes) : m_age(0)
+{
+    std::size_t count = std::max<std::size_t>(megabytes * s_megabyte / sizeof(Bucket), 1);
+    count = std::bit_floor(count);
+
+    // Atomics are value-initialized, so every slot starts out empty
+    m_buckets = std::vector<Bucket>(count);
+    m_bucketMask = count - 1;
+}
+
+//==================================================================================================
+void TranspositionTable::NewSearch()
+{
+    m_age.store((m_age.load(std::memory_order_relaxed) + 1) & s_ageMask, std::memory_order_relaxed);
+}
+
+//==================================================================================================
+bool TranspositionTable::Probe(const hash_type &key, Entry &entry) const
+{
+    for (const Slot &slot : m_buckets[key & m_bucketMask].m_slots)
+    {
+        std::uint64_t data = slot.m_data.load(std::memory_order_relaxed);
+        std::uint64_t check = slot.m_check.load(std::memory_order_relaxed);
+
+        if ((data != 0) && ((check ^ data) == key))
+        {
+            entry = unpack(data);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//==================================================================================================
+void TranspositionTable::Store(const hash_type &key, const Entry &entry)
+{
+    const std::uint8_t age = m_age.load(std::memory_order_relaxed);
+
+    Slot *pReplace = nullptr;
+    int replaceValue = 0;
+
+    for (Slot &slot : m_buckets[key & m_bucketMask].m_slots)
+    {
+        std::uint64_t data = slot.m_data.load(std::memory_order_relaxed);
+        std::uint64_t check = slot.m_check.load(std::memory_order_relaxed);
+
+        // Always overwrite an earlier result for the same position, but keep
+        // its best move if the new result does not have one
+        if ((data == 0) || ((check ^ data) == key))
+        {
+            Entry stored = entry;
+
+            if (stored.m_move.IsNull() && (data != 0))
+            {
+                stored.m_move = unpack(data).m_move;
+            }
+
+            data = pack(stored);
+            slot.m_check.store(key ^ data, std::memory_order_relaxed);
+            slot.m_data.store(data, std::memory_order_relaxed);
+            return;
+        }
+
+        // Otherwise prefer replacing shallow entries from old searches
+        std::uint8_t entryAge = static_cast<std::uint8_t>(data >> s_ageShift) & s_ageMask;
+        int relativeAge = (age - entryAge) & s_ageMask;
+        int value = unpack(data).m_depth - (relativeAge * 4);
+
+        if ((pReplace == nullptr) || (value < replaceValue))
+        {
+            pReplace = &slot;
+            replaceValue = value;
+        }
+    }
+
+    std::uint64_t data = pack(entry);
+    pReplace->m_check.store(key ^ data, std::memory_order_relaxed);
+    pReplace->m_data.store(data, std::memory_order_relaxed);
+}
+
+//==================================================================================================
+std::uint64_t TranspositionTable::pack(const Entry &entry) const
+{
+    std::uint64_t depth = std::clamp<value_type>(entry.m_depth, 0, 0xff);
+
+    return static_cast<std::uint64_t>(entry.m_move.GetData()) |
+        (static_cast<std::uint64_t>(static_cast<std::uint16_t>(entry.m_score)) << s_scoreShift) |
+        (depth << s_depthShift) | (static_cast<std::uint64_t>(entry.m_bound) << s_boundShift) |
+        (static_cast<std::uint64_t>(m_age.load(std::memory_order_relaxed)) << s_ageShift);
+}
+
+//==================================================================================================
+TranspositionTable::Entry TranspositionTable::unpack(const std::uint64_t &data)
+{
+    Entry entry;
+
+    entry.m_move = PackedMove(static_cast<std::uint16_t>(data));
+    entry.m_score = static_cast<value_type>(static_cast<std::uint16_t>(data >> s_scoreShift));
+    entry.m_depth = static_cast<value_type>((data >> s_depthShift) & 0xff);
+    entry.m_bound = static_cast<Bound>((data >> s_boundShift) & 0x3);
+
+    return entry;
+}
+
+} // namespace chessmate
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "game/board_types.h"
+#include "movement/packed_move.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace chessmate {
+
+/**
+ * Class to cache the results of searching positions, keyed by the positions'
+ * Zobrist hash keys. The table is a fixed number of buckets, each holding a few
+ * entries and sized to fit a single cache line.
+ *
+ * The table may be shared between search threads without locking. Each entry
+ * is two 64-bit words: the entry's packed data, and the position's key XOR'd
+ * with that data. A reader only accepts an entry if XOR'ing the two words
+ * reproduces the key it is looking for, so an entry torn by a concurrent write
+ * is simply treated as a miss.
+ *
+ * When a bucket is full, the entry which is shallowest and was stored during
+ * the oldest search is replaced.
+ *
+ * @author Timothy Flynn (trflynn89@gmail.com)
+ * @version October 17, 2026
+ */
+class TranspositionTable
+{
+public:
+    /**
+     * Enumerated list of how a stored score relates to the position's value.
+     */
+    enum Bound : std::uint8_t
+    {
+        EXACT,
+        LOWER,
+        UPPER
+    };
+
+    /**
+     * The data stored for a single position.
+     */
+    struct Entry
+    {
+        PackedMove m_move;
+        value_type m_score;
+        value_type m_depth;
+        Bound m_bound;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param size_t The size of the table, in megabytes.
+     */
+    explicit TranspositionTable(std::size_t);
+
+    /**
+     * Start a new search. Entries stored by earlier searches become preferred
+     * for replacement.
+     */
+    void NewSearch();
+
+    /**
+     * Look up a position in the table.
+     *
+     * @param hash_type The position's hash key.
+     * @param Entry The entry to fill if the position is found.
+     *
+     * @return True if the position was found.
+     */
+    bool Probe(const hash_type &, Entry &) const;
+
+    /**
+     * Store a position in the table.
+     *
+     * @param hash_type The position's hash key.
+     * @param Entry The entry to store.
+     */
+    void Store(const hash_type &, const Entry &);
+
+private:
+    /**
+     * A single entry, as stored in the table.
+     */
+    struct Slot
+    {
+        std::atomic<std::uint64_t> m_check;
+        std::atomic<std::uint64_t> m_data;
+    };
+
+    /**
+     * A group of entries which a position's key may be stored in.
+     */
+    struct alignas(64) Bucket
+    {
+        Slot m_slots[4];
+    };
+
+    /**
+     * Pack an entry and the current search age into one word.
+     *
+     * @param Entry The entry to pack.
+     *
+     * @return The packed entry.
+     */
+    std::uint64_t pack(const Entry &) const;
+
+    /**
+     * Unpack an entry from a word.
+     *
+     * @param uint64_t The packed entry.
+     *
+     * @return The unpacked entry.
+     */
+    static Entry unpack(const std::uint64_t &);
+
+    std::vector<Bucket> m_buckets;
+    hash_type m_bucketMask;
+
+    std::atomic<std::uint8_t> m_age;
+};
+
+} // namespace chessmate
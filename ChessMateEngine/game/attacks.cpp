@@ -0,0 +1,267 @@
+#include "attacks.h"
+
+#include <fly/types/numeric/literals.hpp>
+
+#include <bit>
+
+using namespace fly::literals::numeric_literals;
+
+namespace chessmate {
+
+namespace {
+
+    // Seed for the pseudo-random generator used to search for magic numbers.
+    // Fixed so that the same magics are found on every run.
+    const board_type s_magicSeed = 0x9e3779b97f4a7c15_u64;
+
+    /**
+     * Xorshift64* pseudo-random number generator.
+     */
+    board_type nextRandom(board_type &state)
+    {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545f4914f6cdd1d_u64;
+    }
+
+    /**
+     * Get a square's bit if the given rank and file are on the board.
+     */
+    board_type squareBit(square_type rank, square_type file)
+    {
+        if ((rank >= RANK_1) && (rank <= RANK_8) && (file >= FILE_A) && (file <= FILE_H))
+        {
+            return 1_u64 << GET_SQUARE(rank, file);
+        }
+
+        return 0;
+    }
+
+    /**
+     * Walk each direction of a sliding piece one square at a time, stopping at
+     * (and including) the first occupied square.
+     */
+    board_type slidingAttacks(
+        square_type square,
+        board_type occupied,
+        const std::array<std::array<square_type, 2>, 4> &directions)
+    {
+        board_type attacks = 0;
+
+        for (const auto &direction : directions)
+        {
+            square_type rank = GET_RANK(square) + direction[0];
+            square_type file = GET_FILE(square) + direction[1];
+
+            while (board_type bit = squareBit(rank, file))
+            {
+                attacks |= bit;
+
+                if (occupied & bit)
+                {
+                    break;
+                }
+
+                rank += direction[0];
+                file += direction[1];
+            }
+        }
+
+        return attacks;
+    }
+
+    /**
+     * Get the squares whose occupancy affect a sliding piece's attacks. The
+     * last square in each direction never blocks anything, so it is excluded.
+     */
+    board_type relevantOccupancy(
+        square_type square,
+        const std::array<std::array<square_type, 2>, 4> &directions)
+    {
+        board_type mask = 0;
+
+        for (const auto &direction : directions)
+        {
+            square_type rank = GET_RANK(square) + direction[0];
+            square_type file = GET_FILE(square) + direction[1];
+
+            while (squareBit(rank + direction[0], file + direction[1]))
+            {
+                mask |= squareBit(rank, file);
+
+                rank += direction[0];
+                file += direction[1];
+            }
+        }
+
+        return mask;
+    }
+
+    const std::array<std::array<square_type, 2>, 4> s_bishopDirections = {{
+        {1, 1},
+        {1, -1},
+        {-1, 1},
+        {-1, -1},
+    }};
+
+    const std::array<std::array<square_type, 2>, 4> s_rookDirections = {{
+        {1, 0},
+        {-1, 0},
+        {0, 1},
+        {0, -1},
+    }};
+
+    const std::array<std::array<square_type, 2>, 8> s_knightDeltas = {{
+        {1, 2},
+        {1, -2},
+        {2, 1},
+        {2, -1},
+        {-1, 2},
+        {-1, -2},
+        {-2, 1},
+        {-2, -1},
+    }};
+
+    const std::array<std::array<square_type, 2>, 8> s_kingDeltas = {{
+        {1, 0},
+        {-1, 0},
+        {0, 1},
+        {0, -1},
+        {1, 1},
+        {1, -1},
+        {-1, 1},
+        {-1, -1},
+    }};
+
+} // namespace
+
+const Attacks::Tables Attacks::s_tables;
+
+//==================================================================================================
+Attacks::Tables::Tables()
+{
+    for (square_type i = 0; i < BOARD_SIZE; ++i)
+    {
+        square_type rank = GET_RANK(i);
+        square_type file = GET_FILE(i);
+
+        m_pawnAttacks[WHITE][i] = squareBit(rank + 1, file - 1) | squareBit(rank + 1, file + 1);
+        m_pawnAttacks[BLACK][i] = squareBit(rank - 1, file - 1) | squareBit(rank - 1, file + 1);
+
+        m_knightAttacks[i] = 0;
+        m_kingAttacks[i] = 0;
+
+        for (const auto &delta : s_knightDeltas)
+        {
+            m_knightAttacks[i] |= squareBit(rank + delta[0], file + delta[1]);
+        }
+
+        for (const auto &delta : s_kingDeltas)
+        {
+            m_kingAttacks[i] |= squareBit(rank + delta[0], file + delta[1]);
+        }
+    }
+
+    initializeSlider(s_bishopDirections, m_bishopMagics, m_bishopAttacks);
+    initializeSlider(s_rookDirections, m_rookMagics, m_rookAttacks);
+
+    // Two squares share a line if a slider on one attacks the other on an empty
+    // board. The line is the intersection of both squares' empty-board attacks
+    // in that direction, and the squares between are the intersection of each
+    // square's attacks when blocked by the other.
+    for (square_type i = 0; i < BOARD_SIZE; ++i)
+    {
+        for (square_type j = 0; j < BOARD_SIZE; ++j)
+        {
+            const board_type ends = (1_u64 << i) | (1_u64 << j);
+
+            m_between[i][j] = 0;
+            m_line[i][j] = 0;
+
+            for (const auto *directions : {&s_bishopDirections, &s_rookDirections})
+            {
+                const board_type attacks = slidingAttacks(i, 0, *directions);
+
+                if ((i != j) && (attacks & (1_u64 << j)))
+                {
+                    m_line[i][j] = (attacks & slidingAttacks(j, 0, *directions)) | ends;
+                    m_between[i][j] = slidingAttacks(i, 1_u64 << j, *directions) &
+                        slidingAttacks(j, 1_u64 << i, *directions);
+                }
+            }
+        }
+    }
+}
+
+//==================================================================================================
+void Attacks::Tables::initializeSlider(
+    const std::array<std::array<square_type, 2>, 4> &directions,
+    std::array<Magic, BOARD_SIZE> &magics,
+    std::vector<board_type> &attacks)
+{
+    board_type state = s_magicSeed;
+
+    std::vector<board_type> occupancies;
+    std::vector<board_type> references;
+    std::vector<unsigned int> epochs;
+    unsigned int attempt = 0;
+
+    for (square_type i = 0; i < BOARD_SIZE; ++i)
+    {
+        Magic &magic = magics[i];
+
+        magic.m_mask = relevantOccupancy(i, directions);
+        magic.m_shift = 64 - static_cast<unsigned int>(std::popcount(magic.m_mask));
+        magic.m_offset = attacks.size();
+
+        // Enumerate every subset of the relevant squares (Carry-Rippler) and
+        // record the true attack set for each
+        occupancies.clear();
+        references.clear();
+        board_type occupied = 0;
+
+        do
+        {
+            occupancies.push_back(occupied);
+            references.push_back(slidingAttacks(i, occupied, directions));
+
+            occupied = (occupied - magic.m_mask) & magic.m_mask;
+        } while (occupied != 0);
+
+        attacks.resize(magic.m_offset + occupancies.size());
+        epochs.assign(occupancies.size(), 0);
+
+        // Try sparse random numbers until one maps every subset to an index
+        // without a destructive collision
+        for (bool found = false; !found;)
+        {
+            do
+            {
+                magic.m_magic = nextRandom(state) & nextRandom(state) & nextRandom(state);
+            } while (std::popcount((magic.m_mask * magic.m_magic) >> 56) < 6);
+
+            found = true;
+            ++attempt;
+
+            for (std::size_t j = 0; j < occupancies.size(); ++j)
+            {
+                std::size_t index = magic.Index(occupancies[j]);
+                std::size_t local = index - magic.m_offset;
+
+                if (epochs[local] < attempt)
+                {
+                    epochs[local] = attempt;
+                    attacks[index] = references[j];
+                }
+                else if (attacks[index] != references[j])
+                {
+                    found = false;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+} // namespace chessmate
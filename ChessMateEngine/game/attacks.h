@@ -0,0 +1,225 @@
+#pragma once
+
+#include "game/board_types.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace chessmate {
+
+/**
+ * Class to hold precomputed attack tables for every piece on every square.
+ * Leaping pieces (pawns, knights, kings) are a direct lookup by square. Sliding
+ * pieces (bishops, rooks, queens) use "fancy" magic bitboards: the occupancy of
+ * the squares relevant to a slider is multiplied by a magic number and shifted
+ * to form a perfect hash into a table of attack sets, so every lookup is one
+ * multiply, one shift and one load.
+ *
+ * The tables are built once during static initialization. Attack sets include
+ * the first blocking piece in each direction, regardless of its color.
+ *
+ * Also held are the squares between, and the full line through, every pair of
+ * squares which share a rank, file or diagonal. These are used to find pinned
+ * pieces and the squares which block a check.
+ *
+ * @author Timothy Flynn (trflynn89@gmail.com)
+ * @version October 17, 2026
+ */
+class Attacks
+{
+public:
+    /**
+     * Get the squares attacked by a pawn.
+     *
+     * @param square_type The location of the pawn.
+     * @param color_type The color of the pawn.
+     *
+     * @return The squares attacked by the pawn.
+     */
+    static board_type GetPawnAttacks(square_type, color_type);
+
+    /**
+     * Get the squares attacked by a knight.
+     *
+     * @param square_type The location of the knight.
+     *
+     * @return The squares attacked by the knight.
+     */
+    static board_type GetKnightAttacks(square_type);
+
+    /**
+     * Get the squares attacked by a bishop.
+     *
+     * @param square_type The location of the bishop.
+     * @param board_type The occupied squares of the board.
+     *
+     * @return The squares attacked by the bishop.
+     */
+    static board_type GetBishopAttacks(square_type, board_type);
+
+    /**
+     * Get the squares attacked by a rook.
+     *
+     * @param square_type The location of the rook.
+     * @param board_type The occupied squares of the board.
+     *
+     * @return The squares attacked by the rook.
+     */
+    static board_type GetRookAttacks(square_type, board_type);
+
+    /**
+     * Get the squares attacked by a queen.
+     *
+     * @param square_type The location of the queen.
+     * @param board_type The occupied squares of the board.
+     *
+     * @return The squares attacked by the queen.
+     */
+    static board_type GetQueenAttacks(square_type, board_type);
+
+    /**
+     * Get the squares attacked by a king.
+     *
+     * @param square_type The location of the king.
+     *
+     * @return The squares attacked by the king.
+     */
+    static board_type GetKingAttacks(square_type);
+
+    /**
+     * Get the squares strictly between two squares.
+     *
+     * @param square_type The first square.
+     * @param square_type The second square.
+     *
+     * @return The squares between the two squares, or 0 if they do not share a
+     *         rank, file or diagonal.
+     */
+    static board_type GetBetween(square_type, square_type);
+
+    /**
+     * Get every square on the line through two squares, from edge to edge.
+     *
+     * @param square_type The first square.
+     * @param square_type The second square.
+     *
+     * @return The squares on the line, or 0 if the squares do not share a rank,
+     *         file or diagonal.
+     */
+    static board_type GetLine(square_type, square_type);
+
+private:
+    /**
+     * Magic hashing data for a single square of a single sliding piece.
+     */
+    struct Magic
+    {
+        /**
+         * Hash an occupancy into an index of this square's attack table.
+         *
+         * @param board_type The occupied squares of the board.
+         *
+         * @return The index into the attack table.
+         */
+        std::size_t Index(board_type) const;
+
+        board_type m_mask;
+        board_type m_magic;
+        unsigned int m_shift;
+        std::size_t m_offset;
+    };
+
+    /**
+     * Storage for all attack tables. Construction generates every table and
+     * searches for the magic numbers of each sliding piece.
+     */
+    struct Tables
+    {
+        Tables();
+
+        /**
+         * Find magic numbers for every square of a sliding piece, and fill that
+         * piece's attack table.
+         *
+         * @param array The directions the piece slides in, as (rank, file) deltas.
+         * @param array The magic data to fill.
+         * @param vector The attack table to fill.
+         */
+        void initializeSlider(
+            const std::array<std::array<square_type, 2>, 4> &,
+            std::array<Magic, BOARD_SIZE> &,
+            std::vector<board_type> &);
+
+        std::array<std::array<board_type, BOARD_SIZE>, 2> m_pawnAttacks;
+        std::array<board_type, BOARD_SIZE> m_knightAttacks;
+        std::array<board_type, BOARD_SIZE> m_kingAttacks;
+
+        std::array<Magic, BOARD_SIZE> m_bishopMagics;
+        std::array<Magic, BOARD_SIZE> m_rookMagics;
+
+        std::vector<board_type> m_bishopAttacks;
+        std::vector<board_type> m_rookAttacks;
+
+        std::array<std::array<board_type, BOARD_SIZE>, BOARD_SIZE> m_between;
+        std::array<std::array<board_type, BOARD_SIZE>, BOARD_SIZE> m_line;
+    };
+
+    static const Tables s_tables;
+};
+
+//==================================================================================================
+inline std::size_t Attacks::Magic::Index(board_type occupied) const
+{
+    return m_offset + static_cast<std::size_t>(((occupied & m_mask) * m_magic) >> m_shift);
+}
+
+//==================================================================================================
+inline board_type Attacks::GetPawnAttacks(square_type square, color_type color)
+{
+    return s_tables.m_pawnAttacks[color][square];
+}
+
+//==================================================================================================
+inline board_type Attacks::GetKnightAttacks(square_type square)
+{
+    return s_tables.m_knightAttacks[square];
+}
+
+//==================================================================================================
+inline board_type Attacks::GetBishopAttacks(square_type square, board_type occupied)
+{
+    return s_tables.m_bishopAttacks[s_tables.m_bishopMagics[square].Index(occupied)];
+}
+
+//==================================================================================================
+inline board_type Attacks::GetRookAttacks(square_type square, board_type occupied)
+{
+    return s_tables.m_rookAttacks[s_tables.m_rookMagics[square].Index(occupied)];
+}
+
+//==================================================================================================
+inline board_type Attacks::GetQueenAttacks(square_type square, board_type occupied)
+{
+    return GetBishopAttacks(square, occupied) | GetRookAttacks(square, occupied);
+}
+
+//==================================================================================================
+inline board_type Attacks::GetKingAttacks(square_type square)
+{
+    return s_tables.m_kingAttacks[square];
+}
+
+//==================================================================================================
+inline board_type Attacks::GetBetween(square_type square1, square_type square2)
+{
+    return s_tables.m_between[square1][square2];
+}
+
+//==================================================================================================
+inline board_type Attacks::GetLine(square_type square1, square_type square2)
+{
+    return s_tables.m_line[square1][square2];
+}
+
+} // namespace chessmate
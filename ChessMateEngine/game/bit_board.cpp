@@ -1,11 +1,31 @@
 #include "bit_board.h"
 
+#include "engine/evaluator.h"
+#include "game/attacks.h"
+#include "game/zobrist.h"
+
 #include <fly/types/numeric/literals.hpp>
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <limits>
+
 using namespace fly::literals::numeric_literals;
 
 namespace chessmate {
 
+namespace {
+
+    // Deepest possible exchange, one capture per piece on the board
+    const std::size_t s_maxExchangeLength = 32;
+
+    // Plies since the last null move of a board which has never made one
+    const short s_noNullMove = std::numeric_limits<short>::max();
+
+} // namespace
+
 //==================================================================================================
 BitBoard::BitBoard()
 {
@@ -25,25 +45,32 @@ BitBoard::BitBoard()
     m_endGame = false;
     m_whiteKingLocation = GET_SQUARE(RANK_1, FILE_E);
     m_blackKingLocation = GET_SQUARE(RANK_8, FILE_E);
-    m_whiteMovedKing = false;
-    m_whiteMovedQueen = false;
-    m_whiteMovedKingsideRook = false;
-    m_whiteMovedQueensideRook = false;
-    m_blackMovedKing = false;
-    m_blackMovedQueen = false;
-    m_blackMovedKingsideRook = false;
-    m_blackMovedQueensideRook = false;
+    m_movedPieces = 0;
     m_whiteCastled = false;
     m_blackCastled = false;
     m_fiftyMoveCount = 0;
-    m_repeatedMoveCount = 0;
+    m_pliesSinceNullMove = s_noNullMove;
     m_enPassantColor = NONE;
     m_enPassantPosition = -1;
+    m_hashKey = generateHashKey();
+    m_pawnHashKey = generatePawnHashKey();
+    m_undoStackSize = 0;
 }
 
 //==================================================================================================
-BitBoard::BitBoard(const BitBoard &board)
+BitBoard::BitBoard(const BitBoard &board) : m_undoStackSize(0)
 {
+    *this = board;
+}
+
+//==================================================================================================
+BitBoard &BitBoard::operator=(const BitBoard &board)
+{
+    if (this == &board)
+    {
+        return *this;
+    }
+
     m_pawn = board.m_pawn;
     m_knight = board.m_knight;
     m_bishop = board.m_bishop;
@@ -55,28 +82,38 @@ BitBoard::BitBoard(const BitBoard &board)
 
     m_attackedByWhite = board.m_attackedByWhite;
     m_attackedByBlack = board.m_attackedByBlack;
+    m_hashKey = board.m_hashKey;
+    m_pawnHashKey = board.m_pawnHashKey;
     m_boardScore = board.m_boardScore;
     m_playerInTurn = board.m_playerInTurn;
-    m_lastMove = board.m_lastMove;
     m_whiteInCheck = board.m_whiteInCheck;
     m_blackInCheck = board.m_blackInCheck;
     m_endGame = board.m_endGame;
     m_whiteKingLocation = board.m_whiteKingLocation;
     m_blackKingLocation = board.m_blackKingLocation;
-    m_whiteMovedKing = board.m_whiteMovedKing;
-    m_whiteMovedQueen = board.m_whiteMovedQueen;
-    m_whiteMovedKingsideRook = board.m_whiteMovedKingsideRook;
-    m_whiteMovedQueensideRook = board.m_whiteMovedQueensideRook;
-    m_blackMovedKing = board.m_blackMovedKing;
-    m_blackMovedQueen = board.m_blackMovedQueen;
-    m_blackMovedKingsideRook = board.m_blackMovedKingsideRook;
-    m_blackMovedQueensideRook = board.m_blackMovedQueensideRook;
+    m_movedPieces = board.m_movedPieces;
     m_whiteCastled = board.m_whiteCastled;
     m_blackCastled = board.m_blackCastled;
     m_fiftyMoveCount = board.m_fiftyMoveCount;
-    m_repeatedMoveCount = board.m_repeatedMoveCount;
+    m_pliesSinceNullMove = board.m_pliesSinceNullMove;
     m_enPassantColor = board.m_enPassantColor;
     m_enPassantPosition = board.m_enPassantPosition;
+
+    // A copy is searched from its current position and never unmakes moves
+    // made before it was copied, so only the history needed to detect
+    // repetitions is kept
+    const std::size_t records =
+        std::min(board.m_undoStackSize, static_cast<std::size_t>(m_fiftyMoveCount));
+
+    m_undoStackTail.clear();
+    m_undoStackSize = 0;
+
+    for (std::size_t i = board.m_undoStackSize - records; i < board.m_undoStackSize; ++i)
+    {
+        pushUndoRecord(board.getUndoRecord(i));
+    }
+
+    return *this;
 }
 
 //==================================================================================================
@@ -91,9 +128,34 @@ void BitBoard::MakeMove(Move &move)
     board_type eraseBit = ~(1_u64 << GET_SQUARE(sRank, sFile));
     board_type setBit = (1_u64 << GET_SQUARE(eRank, eFile));
 
+    // Record the state that cannot be recovered from the move itself
+    UndoRecord record;
+    record.m_attackedByWhite = m_attackedByWhite;
+    record.m_attackedByBlack = m_attackedByBlack;
+    record.m_hashKey = m_hashKey;
+    record.m_pawnHashKey = m_pawnHashKey;
+    record.m_capturedPiece = -1;
+    record.m_enPassantColor = m_enPassantColor;
+    record.m_enPassantPosition = m_enPassantPosition;
+    record.m_fiftyMoveCount = m_fiftyMoveCount;
+    record.m_pliesSinceNullMove = m_pliesSinceNullMove;
+    record.m_movedPieces = m_movedPieces;
+    record.m_whiteInCheck = m_whiteInCheck;
+    record.m_blackInCheck = m_blackInCheck;
+    record.m_endGame = m_endGame;
+
+    // Remove the castling rights and en passant square from the hash key, they
+    // are added back once the move has updated them
+    m_hashKey ^= getStateHashKey();
+
     // Increment the fifty move counter
     ++m_fiftyMoveCount;
 
+    if (m_pliesSinceNullMove < s_noNullMove)
+    {
+        ++m_pliesSinceNullMove;
+    }
+
     // Piece color
     color_type color = GetOccupant(sRank, sFile);
 
@@ -101,38 +163,41 @@ void BitBoard::MakeMove(Move &move)
     if (move.IsEnPassant())
     {
         m_fiftyMoveCount = 0;
+        record.m_capturedPiece = PAWN;
 
         board_type enPassantBit = (1_u64 << GET_SQUARE(sRank, eFile));
+        m_hashKey ^= Zobrist::GetPieceKey(!color, PAWN, GET_SQUARE(sRank, eFile));
+        m_pawnHashKey ^= Zobrist::GetPieceKey(!color, PAWN, GET_SQUARE(sRank, eFile));
         m_pawn &= ~enPassantBit;
         m_white &= ~enPassantBit;
         m_black &= ~enPassantBit;
     }
 
     // Check if we captured a piece
-    else if (move.IsCapture())
+    else if (!IsEmpty(eRank, eFile))
     {
         m_fiftyMoveCount = 0;
 
         // Erase end piece
-        if (IsPawn(eRank, eFile))
-        {
-            m_pawn &= ~setBit;
-        }
-        else if (IsKnight(eRank, eFile))
-        {
-            m_knight &= ~setBit;
-        }
-        else if (IsBishop(eRank, eFile))
-        {
-            m_bishop &= ~setBit;
-        }
-        else if (IsRook(eRank, eFile))
+        record.m_capturedPiece = GetPieceType(eRank, eFile);
+        getPieceBoard(record.m_capturedPiece) &= ~setBit;
+
+        const hash_type capturedKey = Zobrist::GetPieceKey(
+            GetOccupant(eRank, eFile),
+            record.m_capturedPiece,
+            GET_SQUARE(eRank, eFile));
+
+        m_hashKey ^= capturedKey;
+
+        if (record.m_capturedPiece == PAWN)
         {
-            m_rook &= ~setBit;
+            m_pawnHashKey ^= capturedKey;
         }
-        else if (IsQueen(eRank, eFile))
+
+        // A rook captured in its corner may no longer be castled with
+        if (record.m_capturedPiece == ROOK)
         {
-            m_queen &= ~setBit;
+            markRookMoved(eRank, eFile);
         }
     }
 
@@ -169,28 +234,7 @@ void BitBoard::MakeMove(Move &move)
         m_rook &= eraseBit;
         m_rook |= setBit;
 
-        if (sRank == RANK_1)
-        {
-            if (sFile == FILE_A)
-            {
-                m_whiteMovedQueensideRook = true;
-            }
-            else if (sFile == FILE_H)
-            {
-                m_whiteMovedKingsideRook = true;
-            }
-        }
-        else if (sRank == RANK_8)
-        {
-            if (sFile == FILE_A)
-            {
-                m_blackMovedQueensideRook = true;
-            }
-            else if (sFile == FILE_H)
-            {
-                m_blackMovedKingsideRook = true;
-            }
-        }
+        markRookMoved(sRank, sFile);
     }
     else if (movingPiece == QUEEN)
     {
@@ -199,11 +243,11 @@ void BitBoard::MakeMove(Move &move)
 
         if (IsWhite(sRank, sFile))
         {
-            m_whiteMovedQueen = true;
+            m_movedPieces |= WHITE_QUEEN;
         }
         else if (IsBlack(sRank, sFile))
         {
-            m_blackMovedQueen = true;
+            m_movedPieces |= BLACK_QUEEN;
         }
     }
     else if (movingPiece == KING)
@@ -214,12 +258,26 @@ void BitBoard::MakeMove(Move &move)
         if (color == WHITE)
         {
             m_whiteKingLocation = GET_SQUARE(eRank, eFile);
-            m_whiteMovedKing = true;
+            m_movedPieces |= WHITE_KING;
         }
         else if (color == BLACK)
         {
             m_blackKingLocation = GET_SQUARE(eRank, eFile);
-            m_blackMovedKing = true;
+            m_movedPieces |= BLACK_KING;
+        }
+    }
+
+    if ((movingPiece >= PAWN) && (color != NONE))
+    {
+        const hash_type movingKey =
+            Zobrist::GetPieceKey(color, movingPiece, GET_SQUARE(sRank, sFile)) ^
+            Zobrist::GetPieceKey(color, movingPiece, GET_SQUARE(eRank, eFile));
+
+        m_hashKey ^= movingKey;
+
+        if (movingPiece == PAWN)
+        {
+            m_pawnHashKey ^= movingKey;
         }
     }
 
@@ -246,6 +304,9 @@ void BitBoard::MakeMove(Move &move)
             m_white &= ~(1_u64 << 7);
             m_rook |= (1_u64 << 5);
             m_white |= (1_u64 << 5);
+
+            m_hashKey ^= Zobrist::GetPieceKey(WHITE, ROOK, 7);
+            m_hashKey ^= Zobrist::GetPieceKey(WHITE, ROOK, 5);
         }
         else
         {
@@ -253,6 +314,9 @@ void BitBoard::MakeMove(Move &move)
             m_black &= ~(1_u64 << 63);
             m_rook |= (1_u64 << 61);
             m_black |= (1_u64 << 61);
+
+            m_hashKey ^= Zobrist::GetPieceKey(BLACK, ROOK, 63);
+            m_hashKey ^= Zobrist::GetPieceKey(BLACK, ROOK, 61);
         }
     }
     else if (move.IsQueensideCastle())
@@ -263,6 +327,9 @@ void BitBoard::MakeMove(Move &move)
             m_white &= ~(1_u64 << 0);
             m_rook |= (1_u64 << 3);
             m_white |= (1_u64 << 3);
+
+            m_hashKey ^= Zobrist::GetPieceKey(WHITE, ROOK, 0);
+            m_hashKey ^= Zobrist::GetPieceKey(WHITE, ROOK, 3);
         }
         else
         {
@@ -270,6 +337,9 @@ void BitBoard::MakeMove(Move &move)
             m_black &= ~(1_u64 << 56);
             m_rook |= (1_u64 << 59);
             m_black |= (1_u64 << 59);
+
+            m_hashKey ^= Zobrist::GetPieceKey(BLACK, ROOK, 56);
+            m_hashKey ^= Zobrist::GetPieceKey(BLACK, ROOK, 59);
         }
     }
 
@@ -280,6 +350,10 @@ void BitBoard::MakeMove(Move &move)
     {
         m_pawn &= ~setBit;
 
+        m_hashKey ^= Zobrist::GetPieceKey(color, PAWN, GET_SQUARE(eRank, eFile));
+        m_hashKey ^= Zobrist::GetPieceKey(color, promoPiece, GET_SQUARE(eRank, eFile));
+        m_pawnHashKey ^= Zobrist::GetPieceKey(color, PAWN, GET_SQUARE(eRank, eFile));
+
         if (promoPiece == KNIGHT)
         {
             m_knight |= setBit;
@@ -309,11 +383,160 @@ void BitBoard::MakeMove(Move &move)
         move.SetCheck();
     }
 
-    // Set last move
-    m_lastMove = move;
+    // Record the move so it may be undone
+    record.m_move = PackedMove(move);
+    pushUndoRecord(record);
+
+    // Change turn player
+    m_playerInTurn = !m_playerInTurn;
+
+    m_hashKey ^= getStateHashKey() ^ Zobrist::GetBlackToMoveKey();
+    assert(m_hashKey == generateHashKey());
+    assert(m_pawnHashKey == generatePawnHashKey());
+}
+
+//==================================================================================================
+void BitBoard::MakeNullMove()
+{
+    UndoRecord record;
+    record.m_attackedByWhite = m_attackedByWhite;
+    record.m_attackedByBlack = m_attackedByBlack;
+    record.m_hashKey = m_hashKey;
+    record.m_pawnHashKey = m_pawnHashKey;
+    record.m_capturedPiece = -1;
+    record.m_enPassantColor = m_enPassantColor;
+    record.m_enPassantPosition = m_enPassantPosition;
+    record.m_fiftyMoveCount = m_fiftyMoveCount;
+    record.m_pliesSinceNullMove = m_pliesSinceNullMove;
+    record.m_movedPieces = m_movedPieces;
+    record.m_whiteInCheck = m_whiteInCheck;
+    record.m_blackInCheck = m_blackInCheck;
+    record.m_endGame = m_endGame;
+
+    pushUndoRecord(record);
+    m_hashKey ^= getStateHashKey();
+
+    // The pass forfeits any en passant capture
+    m_enPassantColor = NONE;
+    m_enPassantPosition = -1;
+
+    // The fifty move counter is left alone, but positions before the pass are
+    // no longer checked for repetitions
+    m_pliesSinceNullMove = 0;
 
     // Change turn player
     m_playerInTurn = !m_playerInTurn;
+
+    m_hashKey ^= getStateHashKey() ^ Zobrist::GetBlackToMoveKey();
+    assert(m_hashKey == generateHashKey());
+}
+
+//==================================================================================================
+void BitBoard::UnmakeMove()
+{
+    assert(m_undoStackSize > 0);
+    const UndoRecord &record = getUndoRecord(m_undoStackSize - 1);
+    const PackedMove &move = record.m_move;
+
+    if (move.IsNull())
+    {
+        m_playerInTurn = !m_playerInTurn;
+
+        m_hashKey = record.m_hashKey;
+        m_enPassantColor = record.m_enPassantColor;
+        m_enPassantPosition = record.m_enPassantPosition;
+        m_fiftyMoveCount = record.m_fiftyMoveCount;
+        m_pliesSinceNullMove = record.m_pliesSinceNullMove;
+
+        popUndoRecord();
+        return;
+    }
+
+    square_type sRank = GET_RANK(move.GetStartSquare());
+    square_type sFile = GET_FILE(move.GetStartSquare());
+    square_type eRank = GET_RANK(move.GetEndSquare());
+    square_type eFile = GET_FILE(move.GetEndSquare());
+
+    board_type startBit = (1_u64 << GET_SQUARE(sRank, sFile));
+    board_type endBit = (1_u64 << GET_SQUARE(eRank, eFile));
+
+    // Change turn player back to the player who made the move
+    m_playerInTurn = !m_playerInTurn;
+
+    board_type &myPieces = ((m_playerInTurn == WHITE) ? m_white : m_black);
+    board_type &oppPieces = ((m_playerInTurn == WHITE) ? m_black : m_white);
+
+    // Return the moving piece to its start square, demoting promoted pawns
+    piece_type endPiece = GetPieceType(eRank, eFile);
+    piece_type startPiece = endPiece;
+
+    if (move.IsPromotion())
+    {
+        startPiece = PAWN;
+    }
+
+    getPieceBoard(endPiece) &= ~endBit;
+    getPieceBoard(startPiece) |= startBit;
+
+    myPieces &= ~endBit;
+    myPieces |= startBit;
+
+    if (startPiece == KING)
+    {
+        if (m_playerInTurn == WHITE)
+        {
+            m_whiteKingLocation = GET_SQUARE(sRank, sFile);
+        }
+        else
+        {
+            m_blackKingLocation = GET_SQUARE(sRank, sFile);
+        }
+    }
+
+    // Restore a captured piece
+    if (record.m_capturedPiece >= PAWN)
+    {
+        board_type capturedBit = endBit;
+
+        if (move.IsEnPassant())
+        {
+            capturedBit = (1_u64 << GET_SQUARE(sRank, eFile));
+        }
+
+        getPieceBoard(record.m_capturedPiece) |= capturedBit;
+        oppPieces |= capturedBit;
+    }
+
+    // Return a castled rook to its corner
+    if (move.IsKingsideCastle() || move.IsQueensideCastle())
+    {
+        square_type rookFile = (move.IsKingsideCastle() ? FILE_H : FILE_A);
+        square_type castledFile = (move.IsKingsideCastle() ? FILE_F : FILE_D);
+
+        board_type rookBit = (1_u64 << GET_SQUARE(sRank, rookFile));
+        board_type castledBit = (1_u64 << GET_SQUARE(sRank, castledFile));
+
+        m_rook &= ~castledBit;
+        m_rook |= rookBit;
+        myPieces &= ~castledBit;
+        myPieces |= rookBit;
+    }
+
+    // Restore the remaining state
+    m_attackedByWhite = record.m_attackedByWhite;
+    m_attackedByBlack = record.m_attackedByBlack;
+    m_hashKey = record.m_hashKey;
+    m_pawnHashKey = record.m_pawnHashKey;
+    m_enPassantColor = record.m_enPassantColor;
+    m_enPassantPosition = record.m_enPassantPosition;
+    m_fiftyMoveCount = record.m_fiftyMoveCount;
+    m_pliesSinceNullMove = record.m_pliesSinceNullMove;
+    m_movedPieces = record.m_movedPieces;
+    m_whiteInCheck = record.m_whiteInCheck;
+    m_blackInCheck = record.m_blackInCheck;
+    m_endGame = record.m_endGame;
+
+    popUndoRecord();
 }
 
 //==================================================================================================
@@ -358,6 +581,50 @@ bool BitBoard::IsKing(const square_type &rank, const square_type &file) const
     return (m_king >> n) & 0x1;
 }
 
+//==================================================================================================
+piece_type BitBoard::GetPieceType(const square_type &rank, const square_type &file) const
+{
+    board_type bit = (1_u64 << GET_SQUARE(rank, file));
+
+    if (m_pawn & bit)
+    {
+        return PAWN;
+    }
+    else if (m_knight & bit)
+    {
+        return KNIGHT;
+    }
+    else if (m_bishop & bit)
+    {
+        return BISHOP;
+    }
+    else if (m_rook & bit)
+    {
+        return ROOK;
+    }
+    else if (m_queen & bit)
+    {
+        return QUEEN;
+    }
+    else if (m_king & bit)
+    {
+        return KING;
+    }
+
+    return -1;
+}
+
+//==================================================================================================
+piece_type BitBoard::GetCapturedPiece(const Move &move) const
+{
+    if (move.IsEnPassant())
+    {
+        return PAWN;
+    }
+
+    return GetPieceType(move.GetEndRank(), move.GetEndFile());
+}
+
 //==================================================================================================
 bool BitBoard::IsWhite(const square_type &rank, const square_type &file) const
 {
@@ -414,381 +681,375 @@ bool BitBoard::IsUnderAttack(
 }
 
 //==================================================================================================
-void BitBoard::generateAttackedSquares()
+unsigned int BitBoard::countRepetitions(unsigned int limit) const
 {
-    m_attackedByWhite = 0x0;
-    m_attackedByBlack = 0x0;
+    const std::size_t plies = std::min(
+        {m_undoStackSize,
+         static_cast<std::size_t>(m_fiftyMoveCount),
+         static_cast<std::size_t>(m_pliesSinceNullMove)});
 
-    // White pieces
-    board_type pawnW = (m_white & m_pawn);
-    board_type knightW = (m_white & m_knight);
-    board_type bishopW = (m_white & m_bishop);
-    board_type rookW = (m_white & m_rook);
-    board_type queenW = (m_white & m_queen);
-    board_type kingW = (m_white & m_king);
+    unsigned int count = 0;
 
-    // Black pieces
-    board_type pawnB = (m_black & m_pawn);
-    board_type knightB = (m_black & m_knight);
-    board_type bishopB = (m_black & m_bishop);
-    board_type rookB = (m_black & m_rook);
-    board_type queenB = (m_black & m_queen);
-    board_type kingB = (m_black & m_king);
+    // Each undo record holds the key of the position before its move. Only
+    // positions with the same player in turn can match, so step back two plies
+    // at a time, starting with the position before the opponent's last move.
+    for (std::size_t i = 2; (i <= plies) && (count < limit); i += 2)
+    {
+        if (getUndoRecord(m_undoStackSize - i).m_hashKey == m_hashKey)
+        {
+            ++count;
+        }
+    }
 
-    board_type allPieces = (m_white | m_black);
-    board_type allPiecesR90 = 0x0;
+    return count;
+}
 
-    // Construct 90-degree rotated bitboards
-    for (square_type i = 0; i < BOARD_SIZE; ++i)
+//==================================================================================================
+void BitBoard::pushUndoRecord(const UndoRecord &record)
+{
+    if (m_undoStackSize < s_inlineUndoRecords)
     {
-        square_type rank = GET_RANK(i);
-        square_type file = GET_FILE(i);
-        allPiecesR90 |= ((allPieces >> i) & 0x1) << GET_SQUARE(file, rank);
+        m_undoStack[m_undoStackSize] = record;
+    }
+    else
+    {
+        m_undoStackTail.push_back(record);
     }
 
-    // PAWN
-    board_type notAFile = 0xfefefefefefefefe;
-    board_type notHFile = 0x7f7f7f7f7f7f7f7f;
-
-    // White - Regular capture moves
-    m_attackedByWhite |= (pawnW << 7_u64) & notHFile & ~m_white;
-    m_attackedByWhite |= (pawnW << 9_u64) & notAFile & ~m_white;
+    ++m_undoStackSize;
+}
 
-    // White - En passant moves
-    if (m_enPassantColor == BLACK)
+//==================================================================================================
+void BitBoard::popUndoRecord()
+{
+    if (m_undoStackSize > s_inlineUndoRecords)
     {
-        m_attackedByWhite |= (pawnW << 7_u64) & ((1_u64 << m_enPassantPosition));
-        m_attackedByWhite |= (pawnW << 9_u64) & ((1_u64 << m_enPassantPosition));
+        m_undoStackTail.pop_back();
     }
 
-    // Black - Regular capture moves
-    m_attackedByBlack |= (pawnB >> 7_u64) & notAFile & ~m_black;
-    m_attackedByBlack |= (pawnB >> 9_u64) & notHFile & ~m_black;
+    --m_undoStackSize;
+}
 
-    // Black - En passant moves
-    if (m_enPassantColor == WHITE)
+//==================================================================================================
+const BitBoard::UndoRecord &BitBoard::getUndoRecord(std::size_t index) const
+{
+    if (index < s_inlineUndoRecords)
     {
-        m_attackedByBlack |= (pawnB >> 7_u64) & ((1_u64 << m_enPassantPosition));
-        m_attackedByBlack |= (pawnB >> 9_u64) & ((1_u64 << m_enPassantPosition));
+        return m_undoStack[index];
     }
 
-    // KNIGHT - White
-    m_attackedByWhite |= (knightW << 6_u64) & ~m_white;
-    m_attackedByWhite |= (knightW << 10_u64) & ~m_white;
-    m_attackedByWhite |= (knightW << 15_u64) & ~m_white;
-    m_attackedByWhite |= (knightW << 17_u64) & ~m_white;
-    m_attackedByWhite |= (knightW >> 6_u64) & ~m_white;
-    m_attackedByWhite |= (knightW >> 10_u64) & ~m_white;
-    m_attackedByWhite |= (knightW >> 15_u64) & ~m_white;
-    m_attackedByWhite |= (knightW >> 17_u64) & ~m_white;
+    return m_undoStackTail[index - s_inlineUndoRecords];
+}
 
-    // KNIGHT - Black
-    m_attackedByBlack |= (knightB << 6_u64) & ~m_black;
-    m_attackedByBlack |= (knightB << 10_u64) & ~m_black;
-    m_attackedByBlack |= (knightB << 15_u64) & ~m_black;
-    m_attackedByBlack |= (knightB << 17_u64) & ~m_black;
-    m_attackedByBlack |= (knightB >> 6_u64) & ~m_black;
-    m_attackedByBlack |= (knightB >> 10_u64) & ~m_black;
-    m_attackedByBlack |= (knightB >> 15_u64) & ~m_black;
-    m_attackedByBlack |= (knightB >> 17_u64) & ~m_black;
+//==================================================================================================
+std::uint8_t BitBoard::getCastlingRights() const
+{
+    std::uint8_t rights = 0;
 
-    // Sliding pieces
-    for (square_type i = 0; i < BOARD_SIZE; ++i)
+    if (!(m_movedPieces & (WHITE_KING | WHITE_KINGSIDE_ROOK)))
     {
-        // BISHOP and QUEEN - White
-        if (((bishopW >> i) & 0x1) || ((queenW >> i) & 0x1))
-        {
-            square_type rank = GET_RANK(i);
-            square_type file = GET_FILE(i);
+        rights |= 1 << 0;
+    }
+    if (!(m_movedPieces & (WHITE_KING | WHITE_QUEENSIDE_ROOK)))
+    {
+        rights |= 1 << 1;
+    }
+    if (!(m_movedPieces & (BLACK_KING | BLACK_KINGSIDE_ROOK)))
+    {
+        rights |= 1 << 2;
+    }
+    if (!(m_movedPieces & (BLACK_KING | BLACK_QUEENSIDE_ROOK)))
+    {
+        rights |= 1 << 3;
+    }
 
-            // North-east
-            for (square_type j = rank + 1, k = file + 1; (j < NUM_RANKS) && (k < NUM_FILES);
-                 ++j, ++k)
-            {
-                square_type n = GET_SQUARE(j, k);
-
-                if ((allPieces >> n) & 0x1)
-                {
-                    m_attackedByWhite |= (1_u64 << n) & ~m_white;
-                    break;
-                }
-                else
-                {
-                    m_attackedByWhite |= (1_u64 << n);
-                }
-            }
+    return rights;
+}
 
-            // North-west
-            for (square_type j = rank + 1, k = file - 1; (j < NUM_RANKS) && (k >= 0); ++j, --k)
-            {
-                square_type n = GET_SQUARE(j, k);
-
-                if ((allPieces >> n) & 0x1)
-                {
-                    m_attackedByWhite |= (1_u64 << n) & ~m_white;
-                    break;
-                }
-                else
-                {
-                    m_attackedByWhite |= (1_u64 << n);
-                }
-            }
+//==================================================================================================
+hash_type BitBoard::getStateHashKey() const
+{
+    hash_type key = Zobrist::GetCastlingKey(getCastlingRights());
 
-            // South-east
-            for (square_type j = rank - 1, k = file + 1; (j >= 0) && (k < NUM_FILES); --j, ++k)
-            {
-                square_type n = GET_SQUARE(j, k);
-
-                if ((allPieces >> n) & 0x1)
-                {
-                    m_attackedByWhite |= (1_u64 << n) & ~m_white;
-                    break;
-                }
-                else
-                {
-                    m_attackedByWhite |= (1_u64 << n);
-                }
-            }
+    if (m_enPassantColor != NONE)
+    {
+        key ^= Zobrist::GetEnPassantKey(GET_FILE(m_enPassantPosition));
+    }
 
-            // South-west
-            for (square_type j = rank - 1, k = file - 1; (j >= 0) && (k >= 0); --j, --k)
-            {
-                square_type n = GET_SQUARE(j, k);
-
-                if ((allPieces >> n) & 0x1)
-                {
-                    m_attackedByWhite |= (1_u64 << n) & ~m_white;
-                    break;
-                }
-                else
-                {
-                    m_attackedByWhite |= (1_u64 << n);
-                }
-            }
+    return key;
+}
+
+//==================================================================================================
+hash_type BitBoard::generateHashKey() const
+{
+    const std::array<board_type, 6> pieces = {m_pawn, m_knight, m_bishop, m_rook, m_queen, m_king};
+    hash_type key = getStateHashKey();
+
+    for (piece_type piece = PAWN; piece <= KING; ++piece)
+    {
+        for (board_type board = (pieces[piece] & m_white); board != 0; board &= board - 1)
+        {
+            key ^= Zobrist::GetPieceKey(WHITE, piece, std::countr_zero(board));
         }
 
-        // BISHOP and QUEEN - Black
-        else if (((bishopB >> i) & 0x1) || ((queenB >> i) & 0x1))
+        for (board_type board = (pieces[piece] & m_black); board != 0; board &= board - 1)
         {
-            square_type rank = GET_RANK(i);
-            square_type file = GET_FILE(i);
+            key ^= Zobrist::GetPieceKey(BLACK, piece, std::countr_zero(board));
+        }
+    }
 
-            // North-east
-            for (square_type j = rank + 1, k = file + 1; (j < NUM_RANKS) && (k < NUM_FILES);
-                 ++j, ++k)
-            {
-                square_type n = GET_SQUARE(j, k);
-
-                if ((allPieces >> n) & 0x1)
-                {
-                    m_attackedByBlack |= (1_u64 << n) & ~m_black;
-                    break;
-                }
-                else
-                {
-                    m_attackedByBlack |= (1_u64 << n);
-                }
-            }
+    if (m_playerInTurn == BLACK)
+    {
+        key ^= Zobrist::GetBlackToMoveKey();
+    }
 
-            // North-west
-            for (square_type j = rank + 1, k = file - 1; (j < NUM_RANKS) && (k >= 0); ++j, --k)
-            {
-                square_type n = GET_SQUARE(j, k);
-
-                if ((allPieces >> n) & 0x1)
-                {
-                    m_attackedByBlack |= (1_u64 << n) & ~m_black;
-                    break;
-                }
-                else
-                {
-                    m_attackedByBlack |= (1_u64 << n);
-                }
-            }
+    return key;
+}
 
-            // South-east
-            for (square_type j = rank - 1, k = file + 1; (j >= 0) && (k < NUM_FILES); --j, ++k)
-            {
-                square_type n = GET_SQUARE(j, k);
-
-                if ((allPieces >> n) & 0x1)
-                {
-                    m_attackedByBlack |= (1_u64 << n) & ~m_black;
-                    break;
-                }
-                else
-                {
-                    m_attackedByBlack |= (1_u64 << n);
-                }
-            }
+//==================================================================================================
+hash_type BitBoard::generatePawnHashKey() const
+{
+    hash_type key = 0;
 
-            // South-west
-            for (square_type j = rank - 1, k = file - 1; (j >= 0) && (k >= 0); --j, --k)
-            {
-                square_type n = GET_SQUARE(j, k);
-
-                if ((allPieces >> n) & 0x1)
-                {
-                    m_attackedByBlack |= (1_u64 << n) & ~m_black;
-                    break;
-                }
-                else
-                {
-                    m_attackedByBlack |= (1_u64 << n);
-                }
-            }
-        }
+    for (board_type board = (m_pawn & m_white); board != 0; board &= board - 1)
+    {
+        key ^= Zobrist::GetPieceKey(WHITE, PAWN, std::countr_zero(board));
+    }
 
-        // ROOK and QUEEN - White
-        if (((rookW >> i) & 0x1) || ((queenW >> i) & 0x1))
-        {
-            square_type rank = GET_RANK(i);
-            square_type file = GET_FILE(i);
-            square_type rankOcc = (allPieces >> (rank * NUM_FILES)) & 0xff;
-            square_type fileOcc = (allPiecesR90 >> (file * NUM_RANKS)) & 0xff;
+    for (board_type board = (m_pawn & m_black); board != 0; board &= board - 1)
+    {
+        key ^= Zobrist::GetPieceKey(BLACK, PAWN, std::countr_zero(board));
+    }
 
-            // North
-            for (square_type j = rank + 1; j < NUM_RANKS; ++j)
-            {
-                if ((fileOcc >> j) & 0x1)
-                {
-                    m_attackedByWhite |= (1_u64 << GET_SQUARE(j, file)) & ~m_white;
-                    break;
-                }
-                else
-                {
-                    m_attackedByWhite |= (1_u64 << GET_SQUARE(j, file));
-                }
-            }
+    return key;
+}
 
-            // South
-            for (square_type j = rank - 1; j >= 0; --j)
-            {
-                if ((fileOcc >> j) & 0x1)
-                {
-                    m_attackedByWhite |= (1_u64 << GET_SQUARE(j, file)) & ~m_white;
-                    break;
-                }
-                else
-                {
-                    m_attackedByWhite |= (1_u64 << GET_SQUARE(j, file));
-                }
-            }
+//==================================================================================================
+void BitBoard::generateAttackedSquares()
+{
+    board_type occupied = (m_white | m_black);
 
-            // East
-            for (square_type j = file + 1; j < NUM_FILES; ++j)
-            {
-                if ((rankOcc >> j) & 0x1)
-                {
-                    m_attackedByWhite |= (1_u64 << GET_SQUARE(rank, j)) & ~m_white;
-                    break;
-                }
-                else
-                {
-                    m_attackedByWhite |= (1_u64 << GET_SQUARE(rank, j));
-                }
-            }
+    m_attackedByWhite = generateAttacks(m_white, WHITE, occupied) & ~m_white;
+    m_attackedByBlack = generateAttacks(m_black, BLACK, occupied) & ~m_black;
+}
 
-            // West
-            for (square_type j = file - 1; j >= 0; --j)
-            {
-                if ((rankOcc >> j) & 0x1)
-                {
-                    m_attackedByWhite |= (1_u64 << GET_SQUARE(rank, j)) & ~m_white;
-                    break;
-                }
-                else
-                {
-                    m_attackedByWhite |= (1_u64 << GET_SQUARE(rank, j));
-                }
-            }
+//==================================================================================================
+board_type BitBoard::generateAttacks(
+    const board_type &pieces,
+    const color_type &color,
+    const board_type &occupied) const
+{
+    board_type attacks = 0x0;
+
+    // PAWN
+    for (board_type pawns = (pieces & m_pawn); pawns != 0; pawns &= pawns - 1)
+    {
+        attacks |= Attacks::GetPawnAttacks(std::countr_zero(pawns), color);
+    }
+
+    // KNIGHT
+    for (board_type knights = (pieces & m_knight); knights != 0; knights &= knights - 1)
+    {
+        attacks |= Attacks::GetKnightAttacks(std::countr_zero(knights));
+    }
+
+    // BISHOP and QUEEN
+    for (board_type bishops = (pieces & (m_bishop | m_queen)); bishops != 0;
+         bishops &= bishops - 1)
+    {
+        attacks |= Attacks::GetBishopAttacks(std::countr_zero(bishops), occupied);
+    }
+
+    // ROOK and QUEEN
+    for (board_type rooks = (pieces & (m_rook | m_queen)); rooks != 0; rooks &= rooks - 1)
+    {
+        attacks |= Attacks::GetRookAttacks(std::countr_zero(rooks), occupied);
+    }
+
+    // KING
+    for (board_type kings = (pieces & m_king); kings != 0; kings &= kings - 1)
+    {
+        attacks |= Attacks::GetKingAttacks(std::countr_zero(kings));
+    }
+
+    return attacks;
+}
+
+//==================================================================================================
+board_type BitBoard::GetCheckers() const
+{
+    const square_type king =
+        ((m_playerInTurn == WHITE) ? m_whiteKingLocation : m_blackKingLocation);
+    const board_type opponent = ((m_playerInTurn == WHITE) ? m_black : m_white);
+    const board_type occupied = (m_white | m_black);
+
+    board_type attackers = Attacks::GetPawnAttacks(king, m_playerInTurn) & m_pawn;
+    attackers |= Attacks::GetKnightAttacks(king) & m_knight;
+    attackers |= Attacks::GetBishopAttacks(king, occupied) & (m_bishop | m_queen);
+    attackers |= Attacks::GetRookAttacks(king, occupied) & (m_rook | m_queen);
+
+    return (attackers & opponent);
+}
+
+//==================================================================================================
+board_type BitBoard::GetPinnedPieces() const
+{
+    const square_type king =
+        ((m_playerInTurn == WHITE) ? m_whiteKingLocation : m_blackKingLocation);
+    const board_type mine = ((m_playerInTurn == WHITE) ? m_white : m_black);
+    const board_type opponent = ((m_playerInTurn == WHITE) ? m_black : m_white);
+    const board_type occupied = (m_white | m_black);
+
+    // Sliders which would attack the king on an empty board
+    board_type snipers = Attacks::GetBishopAttacks(king, 0) & (m_bishop | m_queen);
+    snipers |= Attacks::GetRookAttacks(king, 0) & (m_rook | m_queen);
+    snipers &= opponent;
+
+    board_type pinned = 0;
+
+    for (; snipers != 0; snipers &= snipers - 1)
+    {
+        board_type blockers =
+            Attacks::GetBetween(king, static_cast<square_type>(std::countr_zero(snipers))) &
+            occupied;
+
+        if ((std::popcount(blockers) == 1) && (blockers & mine))
+        {
+            pinned |= blockers;
         }
+    }
 
-        // ROOK and QUEEN - Black
-        else if (((rookB >> i) & 0x1) || ((queenB >> i) & 0x1))
+    return pinned;
+}
+
+//==================================================================================================
+board_type BitBoard::GetKingDangerSquares() const
+{
+    const color_type opponentColor = !m_playerInTurn;
+    const board_type opponent = ((m_playerInTurn == WHITE) ? m_black : m_white);
+    const board_type king = (m_king & ~opponent);
+
+    return generateAttacks(opponent, opponentColor, (m_white | m_black) & ~king);
+}
+
+//==================================================================================================
+board_type BitBoard::GetAttackedSquares(const color_type &color) const
+{
+    return ((color == WHITE) ? m_attackedByWhite : m_attackedByBlack);
+}
+
+//==================================================================================================
+board_type BitBoard::GetPieces(const piece_type &piece) const
+{
+    switch (piece)
+    {
+        case PAWN:
+            return m_pawn;
+        case KNIGHT:
+            return m_knight;
+        case BISHOP:
+            return m_bishop;
+        case ROOK:
+            return m_rook;
+        case QUEEN:
+            return m_queen;
+        default:
+            return m_king;
+    }
+}
+
+//==================================================================================================
+board_type BitBoard::GetColorPieces(const color_type &color) const
+{
+    return ((color == WHITE) ? m_white : m_black);
+}
+
+//==================================================================================================
+board_type BitBoard::GetAttackersTo(const square_type &square, const board_type &occupied) const
+{
+    board_type attackers = Attacks::GetPawnAttacks(square, BLACK) & m_pawn & m_white;
+    attackers |= Attacks::GetPawnAttacks(square, WHITE) & m_pawn & m_black;
+    attackers |= Attacks::GetKnightAttacks(square) & m_knight;
+    attackers |= Attacks::GetBishopAttacks(square, occupied) & (m_bishop | m_queen);
+    attackers |= Attacks::GetRookAttacks(square, occupied) & (m_rook | m_queen);
+    attackers |= Attacks::GetKingAttacks(square) & m_king;
+
+    return (attackers & occupied);
+}
+
+//==================================================================================================
+value_type BitBoard::EvaluateExchange(const Move &move) const
+{
+    const std::array<board_type, 6> pieces = {m_pawn, m_knight, m_bishop, m_rook, m_queen, m_king};
+    const board_type diagonal = (m_bishop | m_queen);
+    const board_type straight = (m_rook | m_queen);
+
+    const square_type start = GET_SQUARE(move.GetStartRank(), move.GetStartFile());
+    const square_type end = GET_SQUARE(move.GetEndRank(), move.GetEndFile());
+    const piece_type captured = GetCapturedPiece(move);
+
+    board_type occupied = (m_white | m_black);
+    board_type from = (1_u64 << start);
+
+    // The pawn captured en passant is not on the end square, but is gone
+    if (move.IsEnPassant())
+    {
+        occupied &= ~(1_u64 << GET_SQUARE(move.GetStartRank(), move.GetEndFile()));
+    }
+
+    board_type attackers = GetAttackersTo(end, occupied);
+    piece_type attacker = move.GetMovingPiece();
+    color_type color = GetOccupant(move.GetStartRank(), move.GetStartFile());
+
+    // The material each capture of the exchange wins, if the exchange stopped
+    // after it
+    std::array<int, s_maxExchangeLength> gain;
+    std::size_t depth = 0;
+
+    gain[depth] = ((captured == -1) ? 0 : Evaluator::GetPieceValue(captured));
+
+    do
+    {
+        ++depth;
+        gain[depth] = Evaluator::GetPieceValue(attacker) - gain[depth - 1];
+
+        // Neither player can gain by continuing the exchange
+        if (std::max(-gain[depth - 1], gain[depth]) < 0)
         {
-            square_type rank = GET_RANK(i);
-            square_type file = GET_FILE(i);
-            square_type rankOcc = (allPieces >> (rank * NUM_FILES)) & 0xff;
-            square_type fileOcc = (allPiecesR90 >> (file * NUM_RANKS)) & 0xff;
+            break;
+        }
 
-            // North
-            for (square_type j = rank + 1; j < NUM_RANKS; ++j)
-            {
-                if ((fileOcc >> j) & 0x1)
-                {
-                    m_attackedByBlack |= (1_u64 << GET_SQUARE(j, file)) & ~m_black;
-                    break;
-                }
-                else
-                {
-                    m_attackedByBlack |= (1_u64 << GET_SQUARE(j, file));
-                }
-            }
+        occupied &= ~from;
+        attackers &= ~from;
 
-            // South
-            for (square_type j = rank - 1; j >= 0; --j)
-            {
-                if ((fileOcc >> j) & 0x1)
-                {
-                    m_attackedByBlack |= (1_u64 << GET_SQUARE(j, file)) & ~m_black;
-                    break;
-                }
-                else
-                {
-                    m_attackedByBlack |= (1_u64 << GET_SQUARE(j, file));
-                }
-            }
+        // Reveal any sliders behind the piece which just captured
+        attackers |= Attacks::GetBishopAttacks(end, occupied) & diagonal;
+        attackers |= Attacks::GetRookAttacks(end, occupied) & straight;
+        attackers &= occupied;
 
-            // East
-            for (square_type j = file + 1; j < NUM_FILES; ++j)
-            {
-                if ((rankOcc >> j) & 0x1)
-                {
-                    m_attackedByBlack |= (1_u64 << GET_SQUARE(rank, j)) & ~m_black;
-                    break;
-                }
-                else
-                {
-                    m_attackedByBlack |= (1_u64 << GET_SQUARE(rank, j));
-                }
-            }
+        // The other player recaptures with their least valuable attacker
+        color = !color;
+        from = 0;
 
-            // West
-            for (square_type j = file - 1; j >= 0; --j)
+        const board_type mine = attackers & ((color == WHITE) ? m_white : m_black);
+
+        for (piece_type piece = PAWN; (piece <= KING) && (from == 0); ++piece)
+        {
+            if (board_type candidates = (mine & pieces[piece]); candidates != 0)
             {
-                if ((rankOcc >> j) & 0x1)
-                {
-                    m_attackedByBlack |= (1_u64 << GET_SQUARE(rank, j)) & ~m_black;
-                    break;
-                }
-                else
-                {
-                    m_attackedByBlack |= (1_u64 << GET_SQUARE(rank, j));
-                }
+                from = (candidates & (~candidates + 1));
+                attacker = piece;
             }
         }
-    }
+    } while ((from != 0) && (depth + 1 < s_maxExchangeLength));
 
-    // KING - White
-    m_attackedByWhite |= (kingW << 1_u64) & ~m_white;
-    m_attackedByWhite |= (kingW << 7_u64) & ~m_white;
-    m_attackedByWhite |= (kingW << 8_u64) & ~m_white;
-    m_attackedByWhite |= (kingW << 9_u64) & ~m_white;
-    m_attackedByWhite |= (kingW >> 1_u64) & ~m_white;
-    m_attackedByWhite |= (kingW >> 7_u64) & ~m_white;
-    m_attackedByWhite |= (kingW >> 8_u64) & ~m_white;
-    m_attackedByWhite |= (kingW >> 9_u64) & ~m_white;
+    // Each player may instead stop the exchange before recapturing
+    while (--depth > 0)
+    {
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+    }
 
-    // KING - Black
-    m_attackedByBlack |= (kingB << 1_u64) & ~m_black;
-    m_attackedByBlack |= (kingB << 7_u64) & ~m_black;
-    m_attackedByBlack |= (kingB << 8_u64) & ~m_black;
-    m_attackedByBlack |= (kingB << 9_u64) & ~m_black;
-    m_attackedByBlack |= (kingB >> 1_u64) & ~m_black;
-    m_attackedByBlack |= (kingB >> 7_u64) & ~m_black;
-    m_attackedByBlack |= (kingB >> 8_u64) & ~m_black;
-    m_attackedByBlack |= (kingB >> 9_u64) & ~m_black;
+    return static_cast<value_type>(gain[0]);
 }
 
 //==================================================================================================
@@ -824,7 +1085,25 @@ bool BitBoard::IsStalemateViaFiftyMoves() const
 //==================================================================================================
 bool BitBoard::IsStalemateViaRepetition() const
 {
-    return (m_repeatedMoveCount >= 3);
+    return (countRepetitions(2) >= 2);
+}
+
+//==================================================================================================
+bool BitBoard::IsRepeatedPosition() const
+{
+    return (countRepetitions(1) >= 1);
+}
+
+//==================================================================================================
+hash_type BitBoard::GetHashKey() const
+{
+    return m_hashKey;
+}
+
+//==================================================================================================
+hash_type BitBoard::GetPawnHashKey() const
+{
+    return m_pawnHashKey;
 }
 
 //==================================================================================================
@@ -854,25 +1133,25 @@ square_type BitBoard::GetWhiteKingLocation() const
 //==================================================================================================
 bool BitBoard::HasWhiteMovedKing() const
 {
-    return m_whiteMovedKing;
+    return (m_movedPieces & WHITE_KING);
 }
 
 //==================================================================================================
 bool BitBoard::HasWhiteMovedQueen() const
 {
-    return m_whiteMovedQueen;
+    return (m_movedPieces & WHITE_QUEEN);
 }
 
 //==================================================================================================
 bool BitBoard::HasWhiteMovedKingsideRook() const
 {
-    return m_whiteMovedKingsideRook;
+    return (m_movedPieces & WHITE_KINGSIDE_ROOK);
 }
 
 //==================================================================================================
 bool BitBoard::HasWhiteMovedQueensideRook() const
 {
-    return m_whiteMovedQueensideRook;
+    return (m_movedPieces & WHITE_QUEENSIDE_ROOK);
 }
 
 //==================================================================================================
@@ -884,25 +1163,25 @@ square_type BitBoard::GetBlackKingLocation() const
 //==================================================================================================
 bool BitBoard::HasBlackMovedKing() const
 {
-    return m_blackMovedKing;
+    return (m_movedPieces & BLACK_KING);
 }
 
 //==================================================================================================
 bool BitBoard::HasBlackMovedQueen() const
 {
-    return m_blackMovedQueen;
+    return (m_movedPieces & BLACK_QUEEN);
 }
 
 //==================================================================================================
 bool BitBoard::HasBlackMovedKingsideRook() const
 {
-    return m_blackMovedKingsideRook;
+    return (m_movedPieces & BLACK_KINGSIDE_ROOK);
 }
 
 //==================================================================================================
 bool BitBoard::HasBlackMovedQueensideRook() const
 {
-    return m_blackMovedQueensideRook;
+    return (m_movedPieces & BLACK_QUEENSIDE_ROOK);
 }
 
 //==================================================================================================
@@ -917,6 +1196,53 @@ bool BitBoard::HasBlackCastled() const
     return m_blackCastled;
 }
 
+//==================================================================================================
+board_type &BitBoard::getPieceBoard(const piece_type &piece)
+{
+    switch (piece)
+    {
+        case PAWN:
+            return m_pawn;
+        case KNIGHT:
+            return m_knight;
+        case BISHOP:
+            return m_bishop;
+        case ROOK:
+            return m_rook;
+        case QUEEN:
+            return m_queen;
+        default:
+            return m_king;
+    }
+}
+
+//==================================================================================================
+void BitBoard::markRookMoved(const square_type &rank, const square_type &file)
+{
+    if (rank == RANK_1)
+    {
+        if (file == FILE_A)
+        {
+            m_movedPieces |= WHITE_QUEENSIDE_ROOK;
+        }
+        else if (file == FILE_H)
+        {
+            m_movedPieces |= WHITE_KINGSIDE_ROOK;
+        }
+    }
+    else if (rank == RANK_8)
+    {
+        if (file == FILE_A)
+        {
+            m_movedPieces |= BLACK_QUEENSIDE_ROOK;
+        }
+        else if (file == FILE_H)
+        {
+            m_movedPieces |= BLACK_KINGSIDE_ROOK;
+        }
+    }
+}
+
 //==================================================================================================
 void BitBoard::recordEnPassant(
     const square_type &sRank,
@@ -2,6 +2,12 @@
 
 #include "game/board_types.h"
 #include "movement/move.h"
+#include "movement/packed_move.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 namespace chessmate {
 
@@ -16,8 +22,16 @@ namespace chessmate {
  * This class also stores information about the state of the board, such as its
  * score (according to board evaluation), if anyone is in check, if stalemate
  * has occurred, the last move to have occurred, if en passant is possible,
- * which side can castle, and counters for game termination (via the 50 move
- * rule or 3 move repetition rule).
+ * which side can castle, and a counter for game termination via the 50 move
+ * rule.
+ *
+ * Every move made on the board pushes a small undo record onto a stack, so
+ * that the move may later be reversed in place with UnmakeMove.
+ *
+ * The board also maintains a Zobrist hash key identifying its position, which
+ * is updated incrementally as moves are made. The undo stack keeps the key of
+ * every earlier position, which is used to detect repeated positions. A second
+ * key covers only the pawns, to identify the pawn structure.
  *
  * @author Timothy Flynn (trflynn89@gmail.com)
  * @version March 3, 2013
@@ -31,12 +45,23 @@ public:
     BitBoard();
 
     /**
-     * Copy constructor.
+     * Copy constructor. The copy keeps only the history needed to detect
+     * repetitions, so moves made before the copy cannot be unmade on it.
      *
      * @param BitBoard The board to copy.
      */
     BitBoard(const BitBoard &);
 
+    /**
+     * Copy assignment operator. Like the copy constructor, only the history
+     * needed to detect repetitions is copied.
+     *
+     * @param BitBoard The board to copy.
+     *
+     * @return A reference to this board.
+     */
+    BitBoard &operator=(const BitBoard &);
+
     /**
      * Move a piece on the board.
      * Note: no validation is performed here. The piece will be moved blindly.
@@ -45,6 +70,21 @@ public:
      */
     void MakeMove(Move &);
 
+    /**
+     * Pass the turn to the opponent without moving a piece, clearing any en
+     * passant. The fifty move counter is unchanged, but positions before the
+     * pass are not considered for repetition of positions after it, since a
+     * position reached again only by passing is not a real repetition.
+     * Note: the player in turn must not be in check.
+     */
+    void MakeNullMove();
+
+    /**
+     * Reverse the last move made on the board, restoring the board to its
+     * exact state before that move was made. The last move may be a null move.
+     */
+    void UnmakeMove();
+
     /**
      * Determine if a piece is a pawn.
      *
@@ -105,6 +145,26 @@ public:
      */
     bool IsKing(const square_type &, const square_type &) const;
 
+    /**
+     * Get the type of the piece that is occupying the given location.
+     *
+     * @param square_type The rank of the piece to check.
+     * @param square_type The file of the piece to check.
+     *
+     * @return The type of the piece, or -1 if the location is empty.
+     */
+    piece_type GetPieceType(const square_type &, const square_type &) const;
+
+    /**
+     * Get the type of piece captured by a move. En passant captures a pawn
+     * which is not on the move's end square.
+     *
+     * @param Move The capturing move.
+     *
+     * @return The type of the captured piece.
+     */
+    piece_type GetCapturedPiece(const Move &) const;
+
     /**
      * Determine if a piece is a white piece.
      *
@@ -156,6 +216,78 @@ public:
      */
     bool IsUnderAttack(const square_type &, const square_type &, const color_type &) const;
 
+    /**
+     * @return The opponent's pieces which are giving check to the player in turn.
+     */
+    board_type GetCheckers() const;
+
+    /**
+     * @return The player in turn's pieces which are pinned to their king, and
+     *         so may only move along the line between the king and the pinner.
+     */
+    board_type GetPinnedPieces() const;
+
+    /**
+     * Get the squares the player in turn's king may not move to. The king is
+     * removed from the board first, so that it cannot retreat along the line
+     * of a slider which is checking it.
+     *
+     * @return Every square attacked or defended by the opponent.
+     */
+    board_type GetKingDangerSquares() const;
+
+    /**
+     * Get the squares attacked by a player, excluding squares occupied by the
+     * player's own pieces.
+     *
+     * @param color_type The color of the attacking player.
+     *
+     * @return The squares attacked by the player.
+     */
+    board_type GetAttackedSquares(const color_type &) const;
+
+    /**
+     * Get every piece, of either color, which attacks a square given a set of
+     * occupied squares. Sliders are blocked only by the given occupied squares,
+     * so removing pieces from the set reveals the sliders behind them.
+     *
+     * @param square_type The square being attacked.
+     * @param board_type The occupied squares of the board.
+     *
+     * @return The pieces attacking the square.
+     */
+    board_type GetAttackersTo(const square_type &, const board_type &) const;
+
+    /**
+     * Statically evaluate the exchange started by a capture: both players are
+     * assumed to recapture on the move's end square with their least valuable
+     * attacker, for as long as it does not lose them material. Sliders behind
+     * a piece which captures (x-rays) join the exchange once it has moved.
+     *
+     * @param Move The capturing move.
+     *
+     * @return The material the moving player wins, or loses if negative.
+     */
+    value_type EvaluateExchange(const Move &) const;
+
+    /**
+     * Get the locations of a type of piece, of both colors.
+     *
+     * @param piece_type The type of piece.
+     *
+     * @return The squares holding that type of piece.
+     */
+    board_type GetPieces(const piece_type &) const;
+
+    /**
+     * Get the locations of every piece of a color.
+     *
+     * @param color_type The color of the pieces.
+     *
+     * @return The squares holding that color's pieces.
+     */
+    board_type GetColorPieces(const color_type &) const;
+
     /**
      * @return True if white is in check after the last move.
      */
@@ -188,6 +320,21 @@ public:
      */
     bool IsStalemateViaRepetition() const;
 
+    /**
+     * @return True if the current position has occurred at least once before.
+     */
+    bool IsRepeatedPosition() const;
+
+    /**
+     * @return The Zobrist hash key of the current position.
+     */
+    hash_type GetHashKey() const;
+
+    /**
+     * @return The Zobrist hash key of the current position's pawns alone.
+     */
+    hash_type GetPawnHashKey() const;
+
     /**
      * @return The current player in turn (WHITE or BLACK).
      */
@@ -272,11 +419,140 @@ public:
     friend std::ostream &operator<<(std::ostream &, const BitBoard &);
 
 private:
+    /**
+     * Bit flags for whether specific pieces have moved.
+     */
+    enum MovedPiece : std::uint8_t
+    {
+        WHITE_KING = 1 << 0,
+        WHITE_QUEEN = 1 << 1,
+        WHITE_KINGSIDE_ROOK = 1 << 2,
+        WHITE_QUEENSIDE_ROOK = 1 << 3,
+        BLACK_KING = 1 << 4,
+        BLACK_QUEEN = 1 << 5,
+        BLACK_KINGSIDE_ROOK = 1 << 6,
+        BLACK_QUEENSIDE_ROOK = 1 << 7
+    };
+
+    /**
+     * State needed to reverse a move which cannot be recovered from the move
+     * itself or from the board after the move was made.
+     */
+    struct UndoRecord
+    {
+        PackedMove m_move;
+        board_type m_attackedByWhite;
+        board_type m_attackedByBlack;
+        hash_type m_hashKey;
+        hash_type m_pawnHashKey;
+        piece_type m_capturedPiece;
+        color_type m_enPassantColor;
+        square_type m_enPassantPosition;
+        short m_fiftyMoveCount;
+        short m_pliesSinceNullMove;
+        std::uint8_t m_movedPieces;
+        bool m_whiteInCheck;
+        bool m_blackInCheck;
+        bool m_endGame;
+    };
+
+    /**
+     * Get the bitboard storing the locations of a type of piece.
+     *
+     * @param piece_type The type of piece.
+     *
+     * @return A reference to the piece's bitboard.
+     */
+    board_type &getPieceBoard(const piece_type &);
+
+    /**
+     * Set the moved flag of the rook which starts on the given corner, if any.
+     *
+     * @param square_type The rank of the corner.
+     * @param square_type The file of the corner.
+     */
+    void markRookMoved(const square_type &, const square_type &);
+
+    /**
+     * Count how many times the current position has occurred before. Only
+     * positions since the last irreversible move (a capture or pawn move) and
+     * since the last null move are checked, as no earlier position can be
+     * repeated.
+     *
+     * @param unsigned The count at which to stop searching.
+     *
+     * @return The number of earlier occurrences, up to the given limit.
+     */
+    unsigned int countRepetitions(unsigned int) const;
+
+    /**
+     * Push a record onto the undo stack, spilling to the heap once the inline
+     * records are full.
+     *
+     * @param UndoRecord The record to push.
+     */
+    void pushUndoRecord(const UndoRecord &);
+
+    /**
+     * Pop the most recent record off of the undo stack.
+     */
+    void popUndoRecord();
+
+    /**
+     * Get a record on the undo stack.
+     *
+     * @param size_t The index of the record, where 0 is the oldest record.
+     *
+     * @return The record.
+     */
+    const UndoRecord &getUndoRecord(std::size_t) const;
+
+    /**
+     * @return The castling rights of both sides, as an index into the Zobrist
+     *         castling keys.
+     */
+    std::uint8_t getCastlingRights() const;
+
+    /**
+     * Get the Zobrist key of the position-dependent state which is not a piece:
+     * the castling rights and the en passant square.
+     *
+     * @return The combined key of that state.
+     */
+    hash_type getStateHashKey() const;
+
+    /**
+     * Compute the Zobrist hash key of the current position from scratch.
+     *
+     * @return The computed hash key.
+     */
+    hash_type generateHashKey() const;
+
+    /**
+     * Compute the Zobrist hash key of the current position's pawns from
+     * scratch.
+     *
+     * @return The computed pawn hash key.
+     */
+    hash_type generatePawnHashKey() const;
+
     /**
      * Set which squares are under attack by both sides.
      */
     void generateAttackedSquares();
 
+    /**
+     * Compute every square attacked by a set of pieces, using the precomputed
+     * attack tables.
+     *
+     * @param board_type The pieces to compute attacks for.
+     * @param color_type The color of those pieces.
+     * @param board_type The occupied squares of the board.
+     *
+     * @return The squares attacked by the pieces.
+     */
+    board_type generateAttacks(const board_type &, const color_type &, const board_type &) const;
+
     /**
      * Set the en passant flags if one is possible.
      *
@@ -310,6 +586,10 @@ private:
     board_type m_attackedByWhite;
     board_type m_attackedByBlack;
 
+    // Zobrist hash key of the current position, and of its pawns alone
+    hash_type m_hashKey;
+    hash_type m_pawnHashKey;
+
     // Score of the board used for evaluation. The score is relative - positive
     // is good for white, negative is good for black
     int m_boardScore;
@@ -317,9 +597,6 @@ private:
     // Current player in turn
     color_type m_playerInTurn;
 
-    // Last move that has occured
-    Move m_lastMove;
-
     // Locations of the king
     square_type m_whiteKingLocation;
     square_type m_blackKingLocation;
@@ -331,27 +608,32 @@ private:
     // Keep track of whether the game is in the end game phase
     bool m_endGame;
 
-    // Flags for whether specific pieces have moved
-    bool m_whiteMovedKing;
-    bool m_whiteMovedQueen;
-    bool m_whiteMovedKingsideRook;
-    bool m_whiteMovedQueensideRook;
-    bool m_blackMovedKing;
-    bool m_blackMovedQueen;
-    bool m_blackMovedKingsideRook;
-    bool m_blackMovedQueensideRook;
+    // Flags for whether specific pieces have moved (see MovedPiece)
+    std::uint8_t m_movedPieces;
 
     // Flags for castling
     bool m_whiteCastled;
     bool m_blackCastled;
 
-    // Counters for game-termination rules
+    // Counter for the fifty move rule, in plies since the last irreversible move
     short m_fiftyMoveCount;
-    short m_repeatedMoveCount;
+
+    // Plies since the last null move, which bounds the search for repetitions
+    short m_pliesSinceNullMove;
 
     // En passant flags
     color_type m_enPassantColor;
     square_type m_enPassantPosition; // 0-63. Position where a pawn would move to.
+
+    // Records for undoing each move made on the board, most recent last. The
+    // oldest records are kept inline, enough for a copied board's history and
+    // a search on top of it, so that copying and searching never allocate.
+    // Only a long game's later records are stored on the heap.
+    static constexpr std::size_t s_inlineUndoRecords = 128;
+
+    std::array<UndoRecord, s_inlineUndoRecords> m_undoStack;
+    std::vector<UndoRecord> m_undoStackTail;
+    std::size_t m_undoStackSize;
 };
 
 } // namespace chessmate
@@ -9,6 +9,7 @@ typedef std::int16_t square_type;
 typedef std::int16_t color_type;
 typedef std::int16_t piece_type;
 typedef std::int16_t value_type;
+typedef std::uint64_t hash_type;
 
 /**
  * Enumerated list of board files.
@@ -8,14 +8,24 @@
 #include <fly/net/socket/tcp_socket.hpp>
 #include <fly/types/string/string.hpp>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
 namespace chessmate {
 
+namespace {
+
+    // Factor by which a client's requested time budget may be shorter or longer
+    // than the configured budget
+    const std::chrono::milliseconds::rep s_timeBudgetScale = 10;
+
+} // namespace
+
 //==================================================================================================
 std::shared_ptr<ChessGame> ChessGame::Create(
     const std::shared_ptr<GameConfig> &spConfig,
+    const std::shared_ptr<fly::task::ParallelTaskRunner> &spTaskRunner,
     std::shared_ptr<TcpSocket> spClientSocket,
     const std::shared_ptr<MoveSet> &spMoveSet,
     const Message &msg)
@@ -34,6 +44,7 @@ std::shared_ptr<ChessGame> ChessGame::Create(
 
     return std::make_shared<ChessGame>(
         spConfig,
+        spTaskRunner,
         spClientSocket,
         spMoveSet,
         engineColor,
@@ -43,6 +54,7 @@ std::shared_ptr<ChessGame> ChessGame::Create(
 //==================================================================================================
 ChessGame::ChessGame(
     const std::shared_ptr<GameConfig> &spConfig,
+    const std::shared_ptr<fly::task::ParallelTaskRunner> &spTaskRunner,
     std::shared_ptr<TcpSocket> spClientSocket,
     const std::shared_ptr<MoveSet> &spMoveSet,
     const color_type &engineColor,
@@ -54,18 +66,38 @@ ChessGame::ChessGame(
     m_maxDepth(2 * difficulty + 1),
     m_checkMaxDepth(m_spConfig->IncreaseEndGameDifficulty()),
     m_spBoard(std::make_shared<BitBoard>()),
-    m_moveSelector(spMoveSet, m_spBoard, engineColor)
+    m_spTranspositionTable(
+        std::make_shared<TranspositionTable>(m_spConfig->TranspositionTableSize())),
+    m_moveSelector(
+        spMoveSet,
+        m_spBoard,
+        m_spTranspositionTable,
+        std::make_shared<SearchParameters>(
+            m_spConfig->LateMoveReductionBase(),
+            m_spConfig->LateMoveReductionDivisor(),
+            m_spConfig->FutilityMargin(),
+            m_spConfig->RazorMargin()),
+        m_spConfig->EvaluationCacheSize(),
+        spTaskRunner,
+        m_spConfig->SearchThreads(difficulty),
+        m_spConfig->UseYoungBrothersWait() ? MoveSelector::YOUNG_BROTHERS_WAIT :
+                                             MoveSelector::LAZY_SMP,
+        engineColor)
 {
+    const unsigned int searchThreads = m_spConfig->SearchThreads(difficulty);
+
     fly::logger::Logger::get("console")->info(
-        "Initialized game {}: Engine color = {}, max depth = {}",
+        "Initialized game {}: Engine color = {}, max depth = {}, search threads = {}",
         m_gameId,
         engineColor,
-        m_maxDepth);
+        m_maxDepth,
+        searchThreads);
     LOGI(
-        "Initialized game {}: Engine color = {}, max depth = {}",
+        "Initialized game {}: Engine color = {}, max depth = {}, search threads = {}",
         m_gameId,
         engineColor,
-        m_maxDepth);
+        m_maxDepth,
+        searchThreads);
 }
 
 //==================================================================================================
@@ -96,7 +128,7 @@ bool ChessGame::IsValid() const
 bool ChessGame::MakeMove(Move &move) const
 {
     ValidMoveSet vms(m_wpMoveSet, m_spBoard);
-    MoveList list = vms.GetMyValidMoves();
+    const MoveList &list = vms.GetMyValidMoves();
 
     // Check all valid moves - if this move is valid, make it
     for (auto it = list.begin(); it != list.end(); ++it)
@@ -152,12 +184,31 @@ bool ChessGame::ProcessMessage(const Message &msg)
     }
 
     // GET MOVE
-    // Use the engine to find a move and send to client
+    // Use the engine to find a move and send to client, within the client's
+    // time budget if one was given
     else if (type == Message::GET_MOVE)
     {
+        const std::chrono::milliseconds defaultBudget = m_spConfig->MoveTimeBudget();
+        std::chrono::milliseconds timeBudget = defaultBudget;
+
+        // A budget of 0 requests the configured budget. Otherwise, the client
+        // may not stray far from the configured budget, unless it is unlimited.
+        if (auto clientBudget = msg.GetTimeBudget(); clientBudget && (clientBudget->count() > 0))
+        {
+            timeBudget = *clientBudget;
+
+            if (defaultBudget.count() > 0)
+            {
+                timeBudget = std::clamp(
+                    timeBudget,
+                    defaultBudget / s_timeBudgetScale,
+                    defaultBudget * s_timeBudgetScale);
+            }
+        }
+
         // Find a move. We know a move will be found - client will only
         // request a move if it knows one can be made.
-        Move move = getBestMove();
+        Move move = getBestMove(timeBudget);
 
         Message m(Message::MAKE_MOVE, makeMoveAndStalemateMsg(move));
         return sendMessage(m);
@@ -223,10 +274,10 @@ bool ChessGame::anyValidMoves() const
 }
 
 //==================================================================================================
-Move ChessGame::getBestMove()
+Move ChessGame::getBestMove(const std::chrono::milliseconds &timeBudget)
 {
     LOGD("Searching for best move: {}", m_gameId);
-    Move m = m_moveSelector.GetBestMove(m_maxDepth);
+    Move m = m_moveSelector.GetBestMove(m_maxDepth, timeBudget);
     LOGD("Best move is {}: {}", m_gameId, m);
 
     m_spBoard->MakeMove(m); // Always promote to queen for now
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/move_selector.h"
+#include "engine/transposition_table.h"
 #include "game/bit_board.h"
 #include "game/game_config.h"
 #include "game/message.h"
@@ -9,6 +10,7 @@
 
 #include <fly/net/socket/concepts.hpp>
 
+#include <chrono>
 #include <memory>
 
 namespace fly::net {
@@ -23,6 +25,10 @@ class TcpSocket;
 
 } // namespace fly::net
 
+namespace fly::task {
+class ParallelTaskRunner;
+} // namespace fly::task
+
 namespace chessmate {
 
 /**
@@ -52,6 +58,7 @@ public:
      * from the game client.
      *
      * @param std::shared_ptr<GameConfig> The game configuration.
+     * @param std::shared_ptr<ParallelTaskRunner> Task runner for helper search threads.
      * @param SocketPtr The game client's socket.
      * @param std::shared_ptr<MoveSet> The list of possible moves.
      * @param Message The START_GAME message containing the client's settings.
@@ -60,6 +67,7 @@ public:
      */
     static std::shared_ptr<ChessGame> Create(
         const std::shared_ptr<GameConfig> &,
+        const std::shared_ptr<fly::task::ParallelTaskRunner> &,
         std::shared_ptr<TcpSocket>,
         const std::shared_ptr<MoveSet> &,
         const Message &);
@@ -68,6 +76,7 @@ public:
      * Constructor to set the game's client socket.
      *
      * @param std::shared_ptr<GameConfig> The game configuration.
+     * @param std::shared_ptr<ParallelTaskRunner> Task runner for helper search threads.
      * @param SocketPtr The game client's socket.
      * @param std::shared_ptr<MoveSet> The list of possible moves.
      * @param color_type The color of the engine.
@@ -75,6 +84,7 @@ public:
      */
     ChessGame(
         const std::shared_ptr<GameConfig> &,
+        const std::shared_ptr<fly::task::ParallelTaskRunner> &,
         std::shared_ptr<TcpSocket>,
         const std::shared_ptr<MoveSet> &,
         const color_type &,
@@ -151,9 +161,11 @@ private:
     /**
      * Use the engine to figure out the best move on the current board.
      *
+     * @param milliseconds The time allowed for the engine to search.
+     *
      * @return The best move calculated by the engine.
      */
-    Move getBestMove();
+    Move getBestMove(const std::chrono::milliseconds &);
 
     const std::shared_ptr<GameConfig> m_spConfig;
 
@@ -166,6 +178,7 @@ private:
     bool m_checkMaxDepth;
 
     std::shared_ptr<BitBoard> m_spBoard;
+    std::shared_ptr<TranspositionTable> m_spTranspositionTable;
 
     MoveSelector m_moveSelector;
 
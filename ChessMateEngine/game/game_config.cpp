@@ -1,11 +1,22 @@
 #include "game_config.h"
 
 #include <fly/types/numeric/literals.hpp>
+#include <fly/types/string/string.hpp>
+
+#include <algorithm>
+#include <array>
 
 using namespace fly::literals::numeric_literals;
 
 namespace chessmate {
 
+namespace {
+
+    // Default number of search threads for each difficulty, from easiest
+    const std::array<unsigned int, 3> s_defaultSearchThreads = {1_u32, 2_u32, 4_u32};
+
+} // namespace
+
 //==================================================================================================
 int GameConfig::AcceptPort() const
 {
@@ -31,4 +42,64 @@ value_type GameConfig::EndGameDifficultyIncrease() const
     return get_value<value_type>("end_game_difficulty_increase", 2);
 }
 
+//==================================================================================================
+std::size_t GameConfig::TranspositionTableSize() const
+{
+    return get_value<std::size_t>("transposition_table_size", 16_zu);
+}
+
+//==================================================================================================
+std::size_t GameConfig::EvaluationCacheSize() const
+{
+    return get_value<std::size_t>("evaluation_cache_size", 1_zu);
+}
+
+//==================================================================================================
+std::chrono::milliseconds GameConfig::MoveTimeBudget() const
+{
+    return std::chrono::milliseconds(
+        get_value<std::chrono::milliseconds::rep>("move_time_budget", 5000_i64));
+}
+
+//==================================================================================================
+unsigned int GameConfig::SearchThreads(const value_type &difficulty) const
+{
+    const value_type maxDifficulty = static_cast<value_type>(s_defaultSearchThreads.size() - 1);
+    const value_type index = std::clamp<value_type>(difficulty, 0, maxDifficulty);
+
+    return get_value<unsigned int>(
+        fly::String::format("search_threads_{}", difficulty),
+        s_defaultSearchThreads[static_cast<std::size_t>(index)]);
+}
+
+//==================================================================================================
+bool GameConfig::UseYoungBrothersWait() const
+{
+    return get_value<bool>("young_brothers_wait", false);
+}
+
+//==================================================================================================
+double GameConfig::LateMoveReductionBase() const
+{
+    return get_value<double>("late_move_reduction_base", 0.75);
+}
+
+//==================================================================================================
+double GameConfig::LateMoveReductionDivisor() const
+{
+    return get_value<double>("late_move_reduction_divisor", 2.25);
+}
+
+//==================================================================================================
+value_type GameConfig::FutilityMargin() const
+{
+    return get_value<value_type>("futility_margin", 150);
+}
+
+//==================================================================================================
+value_type GameConfig::RazorMargin() const
+{
+    return get_value<value_type>("razor_margin", 300);
+}
+
 } // namespace chessmate
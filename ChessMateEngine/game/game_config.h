@@ -5,6 +5,7 @@
 #include <fly/config/config.hpp>
 
 #include <chrono>
+#include <cstddef>
 
 namespace chessmate {
 
@@ -38,6 +39,58 @@ public:
      * @return Amount by which to increase game difficulty during the end game.
      */
     value_type EndGameDifficultyIncrease() const;
+
+    /**
+     * @return Size of each game's transposition table, in megabytes.
+     */
+    std::size_t TranspositionTableSize() const;
+
+    /**
+     * @return Size of each search thread's evaluation cache, in megabytes.
+     */
+    std::size_t EvaluationCacheSize() const;
+
+    /**
+     * @return Time allowed for the engine to search for a move, or 0 for no
+     *         limit. A client may request its own budget, which is clamped to
+     *         within a factor of this budget.
+     */
+    std::chrono::milliseconds MoveTimeBudget() const;
+
+    /**
+     * Get the number of threads a game's engine searches with.
+     *
+     * @param value_type The difficulty of the game.
+     *
+     * @return Number of search threads, including the main search thread.
+     */
+    unsigned int SearchThreads(const value_type &) const;
+
+    /**
+     * @return Whether multi-threaded searches use the Young Brothers Wait
+     *         Concept rather than Lazy SMP.
+     */
+    bool UseYoungBrothersWait() const;
+
+    /**
+     * @return Base of the late move reduction table.
+     */
+    double LateMoveReductionBase() const;
+
+    /**
+     * @return Divisor of the late move reduction table.
+     */
+    double LateMoveReductionDivisor() const;
+
+    /**
+     * @return Futility pruning margin per ply remaining in the search.
+     */
+    value_type FutilityMargin() const;
+
+    /**
+     * @return Razoring margin per ply remaining in the search.
+     */
+    value_type RazorMargin() const;
 };
 
 } // namespace chessmate
@@ -266,8 +266,12 @@ GameManager::createOrFindGame(std::uint64_t socketId, const Message &message)
 
         if (spSocket)
         {
-            std::shared_ptr<ChessGame> spGame =
-                ChessGame::Create(m_spConfig, std::move(spSocket), m_spMoveSet, message);
+            std::shared_ptr<ChessGame> spGame = ChessGame::Create(
+                m_spConfig,
+                m_spTaskRunner,
+                std::move(spSocket),
+                m_spMoveSet,
+                message);
             m_gamesMap[socketId] = spGame;
 
             receive_message(socketId);
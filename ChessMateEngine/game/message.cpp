@@ -3,7 +3,8 @@
 #include <fly/types/string/lexer.hpp>
 #include <fly/types/string/string.hpp>
 
-#include <optional>
+#include <charconv>
+#include <system_error>
 
 namespace chessmate {
 
@@ -65,8 +66,12 @@ bool Message::IsValid() const
             isValid = (m_data.length() > 0);
             break;
 
-        // GET_MOVE, DISCONNECT have no data
+        // GET_MOVE data is empty, or of the form "<time budget in milliseconds>"
         case Message::GET_MOVE:
+            isValid = (m_data.empty() || GetTimeBudget().has_value());
+            break;
+
+        // DISCONNECT has no data
         case Message::DISCONNECT:
             isValid = (m_data.length() == 0);
             break;
@@ -90,6 +95,25 @@ std::string Message::GetData() const
     return m_data;
 }
 
+//==================================================================================================
+std::optional<std::chrono::milliseconds> Message::GetTimeBudget() const
+{
+    std::chrono::milliseconds::rep budget = 0;
+
+    const char *begin = m_data.data();
+    const char *end = begin + m_data.size();
+
+    // The whole string must be a number which fits in the budget's type
+    auto result = std::from_chars(begin, end, budget);
+
+    if ((result.ec != std::errc()) || (result.ptr != end) || (budget < 0))
+    {
+        return std::nullopt;
+    }
+
+    return std::chrono::milliseconds(budget);
+}
+
 //==================================================================================================
 std::string Message::Serialize() const
 {
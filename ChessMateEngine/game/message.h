@@ -2,6 +2,8 @@
 
 #include <fly/types/string/formatters.hpp>
 
+#include <chrono>
+#include <optional>
 #include <string>
 
 namespace chessmate {
@@ -66,6 +68,14 @@ public:
      */
     std::string GetData() const;
 
+    /**
+     * Parse the time budget requested by a GET_MOVE message.
+     *
+     * @return The time budget, or an empty value if the message's data is not
+     *         a non-negative number of milliseconds.
+     */
+    std::optional<std::chrono::milliseconds> GetTimeBudget() const;
+
     /**
      * Return this message as a string.
      *
@@ -0,0 +1,62 @@
+#include "zobrist.h"
+
+#include <fly/types/numeric/literals.hpp>
+
+using namespace fly::literals::numeric_literals;
+
+namespace chessmate {
+
+namespace {
+
+    // Seed for the pseudo-random generator used to create keys
+    const hash_type s_zobristSeed = 0x3243f6a8885a308d_u64;
+
+    /**
+     * Splitmix64 pseudo-random number generator.
+     */
+    hash_type nextRandom(hash_type &state)
+    {
+        hash_type result = (state += 0x9e3779b97f4a7c15_u64);
+        result = (result ^ (result >> 30)) * 0xbf58476d1ce4e5b9_u64;
+        result = (result ^ (result >> 27)) * 0x94d049bb133111eb_u64;
+        return result ^ (result >> 31);
+    }
+
+} // namespace
+
+const Zobrist::Keys Zobrist::s_keys;
+
+//==================================================================================================
+Zobrist::Keys::Keys()
+{
+    hash_type state = s_zobristSeed;
+
+    for (auto &colorKeys : m_pieceKeys)
+    {
+        for (auto &pieceKeys : colorKeys)
+        {
+            for (auto &key : pieceKeys)
+            {
+                key = nextRandom(state);
+            }
+        }
+    }
+
+    // No castling rights hashes to nothing, so a position with no rights has
+    // the same key regardless of how those rights were lost
+    m_castlingKeys[0] = 0;
+
+    for (std::size_t i = 1; i < m_castlingKeys.size(); ++i)
+    {
+        m_castlingKeys[i] = nextRandom(state);
+    }
+
+    for (auto &key : m_enPassantKeys)
+    {
+        key = nextRandom(state);
+    }
+
+    m_blackToMoveKey = nextRandom(state);
+}
+
+} // namespace chessmate
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "game/board_types.h"
+
+#include <array>
+#include <cstdint>
+
+namespace chessmate {
+
+/**
+ * Class to hold the random keys used to compute Zobrist hashes of a board. A
+ * board's hash is the XOR of one key for each piece on each square, plus keys
+ * for the side to move, the castling rights, and the en passant file. Making a
+ * move only needs to XOR in and out the keys that changed.
+ *
+ * The keys are generated once during static initialization from a fixed seed,
+ * so hashes are stable between runs.
+ *
+ * @author Timothy Flynn (trflynn89@gmail.com)
+ * @version October 17, 2026
+ */
+class Zobrist
+{
+public:
+    /**
+     * Number of distinct castling rights combinations.
+     */
+    static constexpr std::size_t s_castlingRightsSize = 16;
+
+    /**
+     * Get the key for a piece on a square.
+     *
+     * @param color_type The color of the piece.
+     * @param piece_type The type of the piece.
+     * @param square_type The location of the piece.
+     *
+     * @return The piece's key.
+     */
+    static hash_type GetPieceKey(color_type, piece_type, square_type);
+
+    /**
+     * Get the key for a set of castling rights.
+     *
+     * @param uint8_t The castling rights, one bit per king and rook pairing.
+     *
+     * @return The castling rights' key.
+     */
+    static hash_type GetCastlingKey(std::uint8_t);
+
+    /**
+     * Get the key for an en passant square.
+     *
+     * @param square_type The file of the en passant square.
+     *
+     * @return The en passant key.
+     */
+    static hash_type GetEnPassantKey(square_type);
+
+    /**
+     * @return The key applied when black is the player in turn.
+     */
+    static hash_type GetBlackToMoveKey();
+
+private:
+    /**
+     * Storage for all keys. Construction generates every key.
+     */
+    struct Keys
+    {
+        Keys();
+
+        std::array<std::array<std::array<hash_type, BOARD_SIZE>, 6>, 2> m_pieceKeys;
+        std::array<hash_type, s_castlingRightsSize> m_castlingKeys;
+        std::array<hash_type, NUM_FILES> m_enPassantKeys;
+        hash_type m_blackToMoveKey;
+    };
+
+    static const Keys s_keys;
+};
+
+//==================================================================================================
+inline hash_type Zobrist::GetPieceKey(color_type color, piece_type piece, square_type square)
+{
+    return s_keys.m_pieceKeys[color][piece][square];
+}
+
+//==================================================================================================
+inline hash_type Zobrist::GetCastlingKey(std::uint8_t rights)
+{
+    return s_keys.m_castlingKeys[rights];
+}
+
+//==================================================================================================
+inline hash_type Zobrist::GetEnPassantKey(square_type file)
+{
+    return s_keys.m_enPassantKeys[file];
+}
+
+//==================================================================================================
+inline hash_type Zobrist::GetBlackToMoveKey()
+{
+    return s_keys.m_blackToMoveKey;
+}
+
+} // namespace chessmate
@@ -0,0 +1,55 @@
+#include "move_list.h"
+
+#include <algorithm>
+
+namespace chessmate {
+
+//==================================================================================================
+MoveList::MoveList() : m_size(0)
+{
+}
+
+//==================================================================================================
+MoveList::MoveList(const_iterator first, const_iterator last) : m_size(0)
+{
+    assign(first, last);
+}
+
+//==================================================================================================
+MoveList::MoveList(MoveList &&list) noexcept : m_size(0)
+{
+    assign(list.begin(), list.end());
+    list.clear();
+}
+
+//==================================================================================================
+MoveList &MoveList::operator=(MoveList &&list) noexcept
+{
+    if (this != &list)
+    {
+        assign(list.begin(), list.end());
+        list.clear();
+    }
+
+    return *this;
+}
+
+//==================================================================================================
+void MoveList::assign(const_iterator first, const_iterator last)
+{
+    assert(static_cast<size_type>(last - first) <= s_capacity);
+
+    std::copy(first, last, m_moves.begin());
+    m_size = static_cast<size_type>(last - first);
+}
+
+//==================================================================================================
+MoveList::iterator MoveList::erase(iterator first, iterator last)
+{
+    iterator newEnd = std::move(last, end(), first);
+    m_size = static_cast<size_type>(newEnd - begin());
+
+    return first;
+}
+
+} // namespace chessmate
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "movement/move.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <span>
+
+namespace chessmate {
+
+/**
+ * Class to store a list of moves without allocating. Moves are stored inline
+ * up to a fixed capacity, which is more than any position allows, so a list
+ * may live on the stack or be reused from a preallocated search frame.
+ *
+ * The list is move-only, so that it is never copied by accident in the search.
+ * A copy of part of a list may be made explicitly with the range constructor.
+ * The container interface mirrors std::vector, so that lists may be used with
+ * range-based loops and the standard algorithms.
+ *
+ * @author Timothy Flynn (trflynn89@gmail.com)
+ */
+class MoveList
+{
+public:
+    typedef std::size_t size_type;
+    typedef Move *iterator;
+    typedef const Move *const_iterator;
+
+    /**
+     * The number of moves a list can hold.
+     */
+    static constexpr size_type s_capacity = 256;
+
+    /**
+     * Default constructor. Creates an empty list.
+     */
+    MoveList();
+
+    /**
+     * Constructor to copy a range of moves into a new list.
+     *
+     * @param const_iterator The first move to copy.
+     * @param const_iterator One past the last move to copy.
+     */
+    MoveList(const_iterator, const_iterator);
+
+    /**
+     * Move constructor. Only the moves in the list are copied.
+     *
+     * @param MoveList The list to move.
+     */
+    MoveList(MoveList &&) noexcept;
+
+    /**
+     * Move assignment operator. Only the moves in the list are copied.
+     *
+     * @param MoveList The list to move.
+     *
+     * @return A reference to this list.
+     */
+    MoveList &operator=(MoveList &&) noexcept;
+
+    MoveList(const MoveList &) = delete;
+    MoveList &operator=(const MoveList &) = delete;
+
+    /**
+     * Replace the moves in the list with a range of moves.
+     *
+     * @param const_iterator The first move to copy.
+     * @param const_iterator One past the last move to copy.
+     */
+    void assign(const_iterator, const_iterator);
+
+    /**
+     * Add a move to the end of the list.
+     *
+     * @param Move The move to add.
+     */
+    void push_back(const Move &);
+
+    /**
+     * Remove a range of moves from the list, shifting later moves down.
+     *
+     * @param iterator The first move to remove.
+     * @param iterator One past the last move to remove.
+     *
+     * @return An iterator to the move after the removed range.
+     */
+    iterator erase(iterator, iterator);
+
+    /**
+     * Remove all moves from the list.
+     */
+    void clear();
+
+    /**
+     * @return The number of moves in the list.
+     */
+    size_type size() const;
+
+    /**
+     * @return True if the list holds no moves.
+     */
+    bool empty() const;
+
+    /**
+     * @return Iterators over the moves in the list.
+     */
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    /**
+     * @return A move in the list by index.
+     */
+    Move &operator[](size_type);
+    const Move &operator[](size_type) const;
+
+    /**
+     * @return A view of the moves in the list.
+     */
+    std::span<Move> GetMoves();
+    std::span<const Move> GetMoves() const;
+
+private:
+    std::array<Move, s_capacity> m_moves;
+    size_type m_size;
+};
+
+//==================================================================================================
+inline void MoveList::push_back(const Move &move)
+{
+    assert(m_size < s_capacity);
+    m_moves[m_size++] = move;
+}
+
+//==================================================================================================
+inline void MoveList::clear()
+{
+    m_size = 0;
+}
+
+//==================================================================================================
+inline MoveList::size_type MoveList::size() const
+{
+    return m_size;
+}
+
+//==================================================================================================
+inline bool MoveList::empty() const
+{
+    return (m_size == 0);
+}
+
+//==================================================================================================
+inline MoveList::iterator MoveList::begin()
+{
+    return m_moves.data();
+}
+
+//==================================================================================================
+inline MoveList::iterator MoveList::end()
+{
+    return m_moves.data() + m_size;
+}
+
+//==================================================================================================
+inline MoveList::const_iterator MoveList::begin() const
+{
+    return m_moves.data();
+}
+
+//==================================================================================================
+inline MoveList::const_iterator MoveList::end() const
+{
+    return m_moves.data() + m_size;
+}
+
+//==================================================================================================
+inline Move &MoveList::operator[](size_type index)
+{
+    return m_moves[index];
+}
+
+//==================================================================================================
+inline const Move &MoveList::operator[](size_type index) const
+{
+    return m_moves[index];
+}
+
+//==================================================================================================
+inline std::span<Move> MoveList::GetMoves()
+{
+    return std::span<Move>(m_moves.data(), m_size);
+}
+
+//==================================================================================================
+inline std::span<const Move> MoveList::GetMoves() const
+{
+    return std::span<const Move>(m_moves.data(), m_size);
+}
+
+} // namespace chessmate
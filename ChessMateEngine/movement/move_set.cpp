@@ -37,121 +37,121 @@ MoveSet::MoveSet() :
 }
 
 //==================================================================================================
-MoveList MoveSet::GetWhitePawnMoves(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetWhitePawnMoves(MoveList::size_type i) const
 {
     return m_whitePawnMoves[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetBlackPawnMoves(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetBlackPawnMoves(MoveList::size_type i) const
 {
     return m_blackPawnMoves[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetKnightMoves(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetKnightMoves(MoveList::size_type i) const
 {
     return m_knightMoves[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetBishopMovesNE(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetBishopMovesNE(MoveList::size_type i) const
 {
     return m_bishopMovesNE[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetBishopMovesNW(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetBishopMovesNW(MoveList::size_type i) const
 {
     return m_bishopMovesNW[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetBishopMovesSE(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetBishopMovesSE(MoveList::size_type i) const
 {
     return m_bishopMovesSE[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetBishopMovesSW(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetBishopMovesSW(MoveList::size_type i) const
 {
     return m_bishopMovesSW[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetRookMovesN(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetRookMovesN(MoveList::size_type i) const
 {
     return m_rookMovesN[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetRookMovesS(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetRookMovesS(MoveList::size_type i) const
 {
     return m_rookMovesS[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetRookMovesE(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetRookMovesE(MoveList::size_type i) const
 {
     return m_rookMovesE[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetRookMovesW(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetRookMovesW(MoveList::size_type i) const
 {
     return m_rookMovesW[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetQueenMovesN(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetQueenMovesN(MoveList::size_type i) const
 {
     return m_queenMovesN[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetQueenMovesS(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetQueenMovesS(MoveList::size_type i) const
 {
     return m_queenMovesS[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetQueenMovesE(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetQueenMovesE(MoveList::size_type i) const
 {
     return m_queenMovesE[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetQueenMovesW(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetQueenMovesW(MoveList::size_type i) const
 {
     return m_queenMovesW[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetQueenMovesNE(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetQueenMovesNE(MoveList::size_type i) const
 {
     return m_queenMovesNE[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetQueenMovesNW(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetQueenMovesNW(MoveList::size_type i) const
 {
     return m_queenMovesNW[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetQueenMovesSE(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetQueenMovesSE(MoveList::size_type i) const
 {
     return m_queenMovesSE[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetQueenMovesSW(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetQueenMovesSW(MoveList::size_type i) const
 {
     return m_queenMovesSW[i];
 }
 
 //==================================================================================================
-MoveList MoveSet::GetKingMoves(MoveList::size_type i) const
+std::span<const Move> MoveSet::GetKingMoves(MoveList::size_type i) const
 {
     return m_kingMoves[i];
 }
@@ -161,7 +161,7 @@ void MoveSet::initializeWhitePawnMoves()
 {
     for (MoveList::size_type i = 8; i < 56; ++i)
     {
-        MoveList &moves = m_whitePawnMoves[i];
+        SquareMoves &moves = m_whitePawnMoves[i];
 
         square_type rank = GET_RANK(i);
         square_type file = GET_FILE(i);
@@ -192,7 +192,7 @@ void MoveSet::initializeBlackPawnMoves()
 {
     for (MoveList::size_type i = 8; i < 56; ++i)
     {
-        MoveList &moves = m_blackPawnMoves[i];
+        SquareMoves &moves = m_blackPawnMoves[i];
 
         square_type rank = GET_RANK(i);
         square_type file = GET_FILE(i);
@@ -223,7 +223,7 @@ void MoveSet::initializeKnightMoves()
 {
     for (MoveList::size_type i = 0; i < BOARD_SIZE; ++i)
     {
-        MoveList &moves = m_knightMoves[i];
+        SquareMoves &moves = m_knightMoves[i];
 
         square_type rank = GET_RANK(i);
         square_type file = GET_FILE(i);
@@ -433,7 +433,7 @@ void MoveSet::initializeKingMoves()
 {
     for (MoveList::size_type i = 0; i < BOARD_SIZE; ++i)
     {
-        MoveList &moves = m_kingMoves[i];
+        SquareMoves &moves = m_kingMoves[i];
 
         square_type rank = GET_RANK(i);
         square_type file = GET_FILE(i);
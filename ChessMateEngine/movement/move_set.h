@@ -1,15 +1,15 @@
 #pragma once
 
 #include "movement/move.h"
+#include "movement/move_list.h"
 
 #include <array>
 #include <list>
+#include <span>
 #include <vector>
 
 namespace chessmate {
 
-typedef std::vector<Move> MoveList;
-
 /**
  * Class to calculate a list of all possible moves for every piece at every
  * possible location, regardless of board setup.
@@ -28,102 +28,102 @@ public:
     /**
      * @return All possible moves a white pawn can make.
      */
-    MoveList GetWhitePawnMoves(MoveList::size_type) const;
+    std::span<const Move> GetWhitePawnMoves(MoveList::size_type) const;
 
     /**
      * @return All possible moves a black pawn can make.
      */
-    MoveList GetBlackPawnMoves(MoveList::size_type) const;
+    std::span<const Move> GetBlackPawnMoves(MoveList::size_type) const;
 
     /**
      * @return All possible moves a knight can make.
      */
-    MoveList GetKnightMoves(MoveList::size_type) const;
+    std::span<const Move> GetKnightMoves(MoveList::size_type) const;
 
     /**
      * @return All possible moves a bishop can make in a NE direction.
      */
-    MoveList GetBishopMovesNE(MoveList::size_type) const;
+    std::span<const Move> GetBishopMovesNE(MoveList::size_type) const;
 
     /**
      * @return All possible moves a bishop can make in a NW direction.
      */
-    MoveList GetBishopMovesNW(MoveList::size_type) const;
+    std::span<const Move> GetBishopMovesNW(MoveList::size_type) const;
 
     /**
      * @return All possible moves a bishop can make in a SE direction.
      */
-    MoveList GetBishopMovesSE(MoveList::size_type) const;
+    std::span<const Move> GetBishopMovesSE(MoveList::size_type) const;
 
     /**
      * @return All possible moves a bishop can make in a SW direction.
      */
-    MoveList GetBishopMovesSW(MoveList::size_type) const;
+    std::span<const Move> GetBishopMovesSW(MoveList::size_type) const;
 
     /**
      * @return All possible moves a rook can make in a N direction.
      */
-    MoveList GetRookMovesN(MoveList::size_type) const;
+    std::span<const Move> GetRookMovesN(MoveList::size_type) const;
 
     /**
      * @return All possible moves a rook can make in a S direction.
      */
-    MoveList GetRookMovesS(MoveList::size_type) const;
+    std::span<const Move> GetRookMovesS(MoveList::size_type) const;
 
     /**
      * @return All possible moves a rook can make in an E direction.
      */
-    MoveList GetRookMovesE(MoveList::size_type) const;
+    std::span<const Move> GetRookMovesE(MoveList::size_type) const;
 
     /**
      * @return All possible moves a rook can make in a W direction.
      */
-    MoveList GetRookMovesW(MoveList::size_type) const;
+    std::span<const Move> GetRookMovesW(MoveList::size_type) const;
 
     /**
      * @return All possible moves a queen can make in a N direction.
      */
-    MoveList GetQueenMovesN(MoveList::size_type) const;
+    std::span<const Move> GetQueenMovesN(MoveList::size_type) const;
 
     /**
      * @return All possible moves a queen can make in a S direction.
      */
-    MoveList GetQueenMovesS(MoveList::size_type) const;
+    std::span<const Move> GetQueenMovesS(MoveList::size_type) const;
 
     /**
      * @return All possible moves a queen can make in an E direction.
      */
-    MoveList GetQueenMovesE(MoveList::size_type) const;
+    std::span<const Move> GetQueenMovesE(MoveList::size_type) const;
 
     /**
      * @return All possible moves a queen can make in a W direction.
      */
-    MoveList GetQueenMovesW(MoveList::size_type) const;
+    std::span<const Move> GetQueenMovesW(MoveList::size_type) const;
 
     /**
      * @return All possible moves a queen can make in a NE direction.
      */
-    MoveList GetQueenMovesNE(MoveList::size_type) const;
+    std::span<const Move> GetQueenMovesNE(MoveList::size_type) const;
 
     /**
      * @return All possible moves a queen can make in a NW direction.
      */
-    MoveList GetQueenMovesNW(MoveList::size_type) const;
+    std::span<const Move> GetQueenMovesNW(MoveList::size_type) const;
 
     /**
      * @return All possible moves a queen can make in a SE direction.
      */
-    MoveList GetQueenMovesSE(MoveList::size_type) const;
+    std::span<const Move> GetQueenMovesSE(MoveList::size_type) const;
 
     /**
      * @return All possible moves a queen can make in a SW direction.
      */
-    MoveList GetQueenMovesSW(MoveList::size_type) const;
+    std::span<const Move> GetQueenMovesSW(MoveList::size_type) const;
 
     /**
      * @return All possible moves a king can make
      */
-    MoveList GetKingMoves(MoveList::size_type) const;
+    std::span<const Move> GetKingMoves(MoveList::size_type) const;
 
 private:
     /**
@@ -161,26 +161,29 @@ private:
      */
     void initializeKingMoves();
 
-    std::vector<MoveList> m_whitePawnMoves;
-    std::vector<MoveList> m_blackPawnMoves;
-    std::vector<MoveList> m_knightMoves;
-    std::vector<MoveList> m_bishopMovesNE;
-    std::vector<MoveList> m_bishopMovesNW;
-    std::vector<MoveList> m_bishopMovesSE;
-    std::vector<MoveList> m_bishopMovesSW;
-    std::vector<MoveList> m_rookMovesN;
-    std::vector<MoveList> m_rookMovesS;
-    std::vector<MoveList> m_rookMovesE;
-    std::vector<MoveList> m_rookMovesW;
-    std::vector<MoveList> m_queenMovesN;
-    std::vector<MoveList> m_queenMovesS;
-    std::vector<MoveList> m_queenMovesE;
-    std::vector<MoveList> m_queenMovesW;
-    std::vector<MoveList> m_queenMovesNE;
-    std::vector<MoveList> m_queenMovesNW;
-    std::vector<MoveList> m_queenMovesSE;
-    std::vector<MoveList> m_queenMovesSW;
-    std::vector<MoveList> m_kingMoves;
+    // The moves a piece can make from a single square
+    typedef std::vector<Move> SquareMoves;
+
+    std::vector<SquareMoves> m_whitePawnMoves;
+    std::vector<SquareMoves> m_blackPawnMoves;
+    std::vector<SquareMoves> m_knightMoves;
+    std::vector<SquareMoves> m_bishopMovesNE;
+    std::vector<SquareMoves> m_bishopMovesNW;
+    std::vector<SquareMoves> m_bishopMovesSE;
+    std::vector<SquareMoves> m_bishopMovesSW;
+    std::vector<SquareMoves> m_rookMovesN;
+    std::vector<SquareMoves> m_rookMovesS;
+    std::vector<SquareMoves> m_rookMovesE;
+    std::vector<SquareMoves> m_rookMovesW;
+    std::vector<SquareMoves> m_queenMovesN;
+    std::vector<SquareMoves> m_queenMovesS;
+    std::vector<SquareMoves> m_queenMovesE;
+    std::vector<SquareMoves> m_queenMovesW;
+    std::vector<SquareMoves> m_queenMovesNE;
+    std::vector<SquareMoves> m_queenMovesNW;
+    std::vector<SquareMoves> m_queenMovesSE;
+    std::vector<SquareMoves> m_queenMovesSW;
+    std::vector<SquareMoves> m_kingMoves;
 };
 
 } // namespace chessmate
@@ -0,0 +1,85 @@
+#include "packed_move.h"
+
+#include "game/bit_board.h"
+
+namespace chessmate {
+
+//==================================================================================================
+PackedMove::PackedMove() : m_data(0)
+{
+}
+
+//==================================================================================================
+PackedMove::PackedMove(std::uint16_t data) : m_data(data)
+{
+}
+
+//==================================================================================================
+PackedMove::PackedMove(const Move &move)
+{
+    std::uint16_t start = GET_SQUARE(move.GetStartRank(), move.GetStartFile());
+    std::uint16_t end = GET_SQUARE(move.GetEndRank(), move.GetEndFile());
+    std::uint16_t promotion = 0;
+    std::uint16_t flag = NORMAL;
+
+    if (move.GetPromotionPiece() > PAWN)
+    {
+        promotion = move.GetPromotionPiece() - KNIGHT;
+        flag = PROMOTION;
+    }
+    else if (move.IsEnPassant())
+    {
+        flag = EN_PASSANT;
+    }
+    else if (move.IsKingsideCastle() || move.IsQueensideCastle())
+    {
+        flag = CASTLE;
+    }
+
+    m_data = start | (end << 6) | (promotion << 12) | (flag << 14);
+}
+
+//==================================================================================================
+Move PackedMove::Unpack(const BitBoard &board) const
+{
+    const square_type start = GetStartSquare();
+    const square_type end = GetEndSquare();
+
+    Move move(GET_RANK(start), GET_FILE(start), GET_RANK(end), GET_FILE(end));
+    move.SetMovingPiece(board.GetPieceType(GET_RANK(start), GET_FILE(start)));
+
+    if (!board.IsEmpty(GET_RANK(end), GET_FILE(end)))
+    {
+        move.SetCapture();
+    }
+
+    switch (getFlag())
+    {
+        case PROMOTION:
+            move.SetPromotionPiece(GetPromotionPiece());
+            break;
+
+        case EN_PASSANT:
+            move.SetCapture();
+            move.SetEnPassant();
+            break;
+
+        case CASTLE:
+            if (IsKingsideCastle())
+            {
+                move.SetKingsideCastle();
+            }
+            else
+            {
+                move.SetQueensideCastle();
+            }
+            break;
+
+        case NORMAL:
+            break;
+    }
+
+    return move;
+}
+
+} // namespace chessmate
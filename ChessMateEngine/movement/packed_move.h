@@ -0,0 +1,200 @@
+#pragma once
+
+#include "game/board_types.h"
+#include "movement/move.h"
+
+#include <cstdint>
+
+namespace chessmate {
+
+class BitBoard;
+
+/**
+ * Class to store a move in 16 bits, for the engine's internal bookkeeping
+ * (undo records, the transposition table, move ordering tables). The rich Move
+ * class remains the format used for PGN strings and the client protocol.
+ *
+ * The bits are laid out as follows:
+ * - Bits 0-5: The start square.
+ * - Bits 6-11: The end square.
+ * - Bits 12-13: The promotion piece, offset from a knight.
+ * - Bits 14-15: A flag for a special move (promotion, en passant, castle).
+ *
+ * A move from A1 to A1 is impossible, so a packed move of 0 means no move.
+ *
+ * @author Timothy Flynn (trflynn89@gmail.com)
+ * @version October 17, 2026
+ */
+class PackedMove
+{
+public:
+    /**
+     * Default constructor. Creates a null move.
+     */
+    PackedMove();
+
+    /**
+     * Constructor to wrap a move which has already been packed.
+     *
+     * @param uint16_t The packed move data.
+     */
+    explicit PackedMove(std::uint16_t);
+
+    /**
+     * Constructor to pack a move.
+     *
+     * @param Move The move to pack.
+     */
+    explicit PackedMove(const Move &);
+
+    /**
+     * Expand the packed move into a full move. The moving piece and whether the
+     * move is a capture are recovered from the board.
+     *
+     * @param BitBoard The board the move is to be made on.
+     *
+     * @return The expanded move.
+     */
+    Move Unpack(const BitBoard &) const;
+
+    /**
+     * @return The move's start square.
+     */
+    square_type GetStartSquare() const;
+
+    /**
+     * @return The move's end square.
+     */
+    square_type GetEndSquare() const;
+
+    /**
+     * @return The move's promotion piece, or -1 if the move is not a promotion.
+     */
+    piece_type GetPromotionPiece() const;
+
+    /**
+     * @return True if this move is a pawn promotion.
+     */
+    bool IsPromotion() const;
+
+    /**
+     * @return True if this move is an en passant.
+     */
+    bool IsEnPassant() const;
+
+    /**
+     * @return True if this move is a kingside castle.
+     */
+    bool IsKingsideCastle() const;
+
+    /**
+     * @return True if this move is a queenside castle.
+     */
+    bool IsQueensideCastle() const;
+
+    /**
+     * @return True if this is the null move.
+     */
+    bool IsNull() const;
+
+    /**
+     * @return The packed move data.
+     */
+    std::uint16_t GetData() const;
+
+    /**
+     * Overloaded operator == for comparing packed moves.
+     *
+     * @param PackedMove The move to compare.
+     *
+     * @return True if the moves are identical, false otherwise.
+     */
+    bool operator==(const PackedMove &) const;
+
+private:
+    /**
+     * Enumerated list of special moves.
+     */
+    enum Flag : std::uint16_t
+    {
+        NORMAL,
+        PROMOTION,
+        EN_PASSANT,
+        CASTLE
+    };
+
+    /**
+     * @return The move's special move flag.
+     */
+    Flag getFlag() const;
+
+    std::uint16_t m_data;
+};
+
+//==================================================================================================
+inline square_type PackedMove::GetStartSquare() const
+{
+    return static_cast<square_type>(m_data & 0x3f);
+}
+
+//==================================================================================================
+inline square_type PackedMove::GetEndSquare() const
+{
+    return static_cast<square_type>((m_data >> 6) & 0x3f);
+}
+
+//==================================================================================================
+inline piece_type PackedMove::GetPromotionPiece() const
+{
+    return (IsPromotion() ? static_cast<piece_type>(KNIGHT + ((m_data >> 12) & 0x3)) : -1);
+}
+
+//==================================================================================================
+inline bool PackedMove::IsPromotion() const
+{
+    return (getFlag() == PROMOTION);
+}
+
+//==================================================================================================
+inline bool PackedMove::IsEnPassant() const
+{
+    return (getFlag() == EN_PASSANT);
+}
+
+//==================================================================================================
+inline bool PackedMove::IsKingsideCastle() const
+{
+    return ((getFlag() == CASTLE) && (GetEndSquare() > GetStartSquare()));
+}
+
+//==================================================================================================
+inline bool PackedMove::IsQueensideCastle() const
+{
+    return ((getFlag() == CASTLE) && (GetEndSquare() < GetStartSquare()));
+}
+
+//==================================================================================================
+inline bool PackedMove::IsNull() const
+{
+    return (m_data == 0);
+}
+
+//==================================================================================================
+inline std::uint16_t PackedMove::GetData() const
+{
+    return m_data;
+}
+
+//==================================================================================================
+inline bool PackedMove::operator==(const PackedMove &move) const
+{
+    return (m_data == move.m_data);
+}
+
+//==================================================================================================
+inline PackedMove::Flag PackedMove::getFlag() const
+{
+    return static_cast<Flag>(m_data >> 14);
+}
+
+} // namespace chessmate
@@ -1,108 +1,412 @@
 #include "valid_move_set.h"
 
+#include "game/attacks.h"
+
+#include <fly/types/numeric/literals.hpp>
+
+#include <bit>
+
+using namespace fly::literals::numeric_literals;
+
 namespace chessmate {
 
 namespace {
 
-    // Attacking piece values - better to attack with pawn than queen
-    const value_type s_pawnValue = 6;
-    const value_type s_knightValue = 3;
-    const value_type s_bishopValue = 3;
-    const value_type s_rookValue = 2;
-    const value_type s_queenValue = 1;
-    // const value_type s_kingValue = 1;
+    // Squares a pawn may move from; a pawn on the last rank has no moves
+    const board_type s_pawnSquares = 0x00ffffffffffff00_u64;
 
 } // namespace
 
+//==================================================================================================
+ValidMoveSet::ValidMoveSet() :
+    m_kingSquare(0),
+    m_pinnedPieces(0),
+    m_kingDangerSquares(0),
+    m_checkMask(0)
+{
+}
+
 //==================================================================================================
 ValidMoveSet::ValidMoveSet(
     const std::weak_ptr<MoveSet> &wpMoveSet,
-    const std::shared_ptr<BitBoard> &spBoard)
+    const std::shared_ptr<BitBoard> &spBoard) :
+    ValidMoveSet()
 {
     std::shared_ptr<MoveSet> spMoveSet = wpMoveSet.lock();
 
-    for (MoveList::size_type i = 0; i < BOARD_SIZE; ++i)
+    if (spMoveSet && spBoard)
     {
-        m_attackValue[i] = 0;
-        m_defendValue[i] = 0;
+        Generate(*spMoveSet, *spBoard);
     }
+}
 
-    if (spMoveSet && spBoard)
+//==================================================================================================
+void ValidMoveSet::Generate(const MoveSet &moveSet, BitBoard &board)
+{
+    reset();
+    findMoveConstraints(board);
+    generateValidMoves(moveSet, board);
+}
+
+//==================================================================================================
+void ValidMoveSet::GenerateCaptures(BitBoard &board)
+{
+    reset();
+    findMoveConstraints(board);
+
+    const board_type opponent = board.GetColorPieces(!board.GetPlayerInTurn());
+    generateMovesTo(board, ~0_u64, opponent, opponent);
+}
+
+//==================================================================================================
+void ValidMoveSet::GenerateQuiets(BitBoard &board)
+{
+    reset();
+    findMoveConstraints(board);
+
+    const board_type empty =
+        ~(board.GetColorPieces(board.GetPlayerInTurn()) |
+          board.GetColorPieces(!board.GetPlayerInTurn()));
+
+    generateMovesTo(board, ~0_u64, empty, empty);
+    generateCastlingMoves(board);
+}
+
+//==================================================================================================
+void ValidMoveSet::GenerateEvasions(BitBoard &board)
+{
+    reset();
+    findMoveConstraints(board);
+
+    // Other pieces must capture or block the checking piece, but the king may
+    // step to any square which is not attacked
+    const board_type mine = board.GetColorPieces(board.GetPlayerInTurn());
+    generateMovesTo(board, ~0_u64, m_checkMask & ~mine, ~mine);
+}
+
+//==================================================================================================
+bool ValidMoveSet::FindLegalMove(BitBoard &board, const PackedMove &packed, Move &move)
+{
+    reset();
+    findMoveConstraints(board);
+
+    const board_type mine = board.GetColorPieces(board.GetPlayerInTurn());
+    const square_type start = packed.GetStartSquare();
+
+    if (((mine >> start) & 0x1) == 0)
+    {
+        return false;
+    }
+
+    generateMovesTo(board, 1_u64 << start, ~mine, ~mine);
+
+    if (start == m_kingSquare)
+    {
+        generateCastlingMoves(board);
+    }
+
+    for (const Move &legal : m_myValidMoves)
+    {
+        if (PackedMove(legal) == packed)
+        {
+            move = legal;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//==================================================================================================
+bool ValidMoveSet::HasLegalMoves(BitBoard &board)
+{
+    reset();
+    findMoveConstraints(board);
+
+    const board_type mine = board.GetColorPieces(board.GetPlayerInTurn());
+
+    // A king step is the cheapest move to find. Castling never needs to be
+    // checked, since the king could also step to the square it passes over.
+    if ((Attacks::GetKingAttacks(m_kingSquare) & ~mine & ~m_kingDangerSquares) != 0)
+    {
+        return true;
+    }
+    else if (m_checkMask == 0)
+    {
+        return false;
+    }
+
+    generateMovesTo(board, ~0_u64, m_checkMask & ~mine, 0);
+    return !m_myValidMoves.empty();
+}
+
+//==================================================================================================
+void ValidMoveSet::reset()
+{
+    m_myValidMoves.clear();
+    m_oppValidMoves.clear();
+}
+
+//==================================================================================================
+void ValidMoveSet::findMoveConstraints(const BitBoard &board)
+{
+    color_type playerInTurn = board.GetPlayerInTurn();
+
+    // Find what constrains the turn player's moves once, so that each move's
+    // legality is a few mask tests rather than making the move
+    m_kingSquare =
+        ((playerInTurn == WHITE) ? board.GetWhiteKingLocation() : board.GetBlackKingLocation());
+    m_pinnedPieces = board.GetPinnedPieces();
+    m_kingDangerSquares = board.GetKingDangerSquares();
+
+    board_type checkers = board.GetCheckers();
+
+    if (checkers == 0)
+    {
+        m_checkMask = ~0_u64;
+    }
+    else if (std::popcount(checkers) == 1)
+    {
+        // A single check may be captured or blocked
+        square_type checker = static_cast<square_type>(std::countr_zero(checkers));
+        m_checkMask = (checkers | Attacks::GetBetween(m_kingSquare, checker));
+    }
+    else
+    {
+        // Only the king may escape a double check
+        m_checkMask = 0;
+    }
+}
+
+//==================================================================================================
+void ValidMoveSet::generateMovesTo(
+    BitBoard &board,
+    board_type from,
+    board_type targets,
+    board_type kingTargets)
+{
+    const color_type playerInTurn = board.GetPlayerInTurn();
+    const board_type mine = board.GetColorPieces(playerInTurn);
+    const board_type opponent = board.GetColorPieces(!playerInTurn);
+    const board_type occupied = (mine | opponent);
+
+    /***** PAWN *****/
+
+    const square_type forward = ((playerInTurn == WHITE) ? 8 : -8);
+    const square_type startRank = ((playerInTurn == WHITE) ? RANK_2 : RANK_7);
+
+    for (board_type pawns = (board.GetPieces(PAWN) & mine & from & s_pawnSquares); pawns != 0;
+         pawns &= pawns - 1)
+    {
+        const square_type start = static_cast<square_type>(std::countr_zero(pawns));
+        const board_type attacks = Attacks::GetPawnAttacks(start, playerInTurn);
+
+        addMyMovesIfLegal(board, PAWN, start, attacks & opponent & targets);
+
+        // En passant does not capture on its end square, so it is checked
+        // against the square of the pawn it captures instead
+        if (board.GetEnPassantColor() == !playerInTurn)
+        {
+            const square_type end = board.GetEnPassantPosition();
+
+            if (((attacks >> end) & 0x1) && ((targets >> (end - forward)) & 0x1))
+            {
+                Move move(GET_RANK(start), GET_FILE(start), GET_RANK(end), GET_FILE(end));
+                move.SetCapture();
+                move.SetEnPassant();
+                move.SetMovingPiece(PAWN);
+
+                addMyMoveIfLegal(board, move);
+            }
+        }
+
+        // Straight, only if the square in front is empty
+        const square_type single = start + forward;
+
+        if (((occupied >> single) & 0x1) == 0)
+        {
+            addMyMovesIfLegal(board, PAWN, start, (1_u64 << single) & targets);
+
+            const square_type twice = single + forward;
+
+            if ((GET_RANK(start) == startRank) && (((occupied >> twice) & 0x1) == 0))
+            {
+                addMyMovesIfLegal(board, PAWN, start, (1_u64 << twice) & targets);
+            }
+        }
+    }
+
+    /***** KNIGHT *****/
+
+    for (board_type knights = (board.GetPieces(KNIGHT) & mine & from); knights != 0;
+         knights &= knights - 1)
+    {
+        const square_type start = static_cast<square_type>(std::countr_zero(knights));
+        addMyMovesIfLegal(board, KNIGHT, start, Attacks::GetKnightAttacks(start) & targets);
+    }
+
+    /***** BISHOP *****/
+
+    for (board_type bishops = (board.GetPieces(BISHOP) & mine & from); bishops != 0;
+         bishops &= bishops - 1)
+    {
+        const square_type start = static_cast<square_type>(std::countr_zero(bishops));
+        addMyMovesIfLegal(
+            board,
+            BISHOP,
+            start,
+            Attacks::GetBishopAttacks(start, occupied) & targets);
+    }
+
+    /***** ROOK *****/
+
+    for (board_type rooks = (board.GetPieces(ROOK) & mine & from); rooks != 0; rooks &= rooks - 1)
+    {
+        const square_type start = static_cast<square_type>(std::countr_zero(rooks));
+        addMyMovesIfLegal(board, ROOK, start, Attacks::GetRookAttacks(start, occupied) & targets);
+    }
+
+    /***** QUEEN *****/
+
+    for (board_type queens = (board.GetPieces(QUEEN) & mine & from); queens != 0;
+         queens &= queens - 1)
     {
-        generateValidMoves(spMoveSet, spBoard);
+        const square_type start = static_cast<square_type>(std::countr_zero(queens));
+        addMyMovesIfLegal(
+            board,
+            QUEEN,
+            start,
+            Attacks::GetQueenAttacks(start, occupied) & targets);
+    }
+
+    /***** KING *****/
+
+    if ((from >> m_kingSquare) & 0x1)
+    {
+        addMyMovesIfLegal(
+            board,
+            KING,
+            m_kingSquare,
+            Attacks::GetKingAttacks(m_kingSquare) & kingTargets);
     }
 }
 
 //==================================================================================================
-void ValidMoveSet::generateValidMoves(
-    const std::shared_ptr<MoveSet> &spMoveSet,
-    const std::shared_ptr<BitBoard> &spBoard)
+void ValidMoveSet::generateCastlingMoves(BitBoard &board)
 {
-    color_type playerInTurn = spBoard->GetPlayerInTurn();
+    const color_type playerInTurn = board.GetPlayerInTurn();
+
+    const bool movedKing =
+        ((playerInTurn == WHITE) ? board.HasWhiteMovedKing() : board.HasBlackMovedKing());
+    const bool inCheck =
+        ((playerInTurn == WHITE) ? board.IsWhiteInCheck() : board.IsBlackInCheck());
+
+    if (movedKing || inCheck)
+    {
+        return;
+    }
+
+    const bool movedKingsideRook =
+        ((playerInTurn == WHITE) ? board.HasWhiteMovedKingsideRook() :
+                                   board.HasBlackMovedKingsideRook());
+    const bool movedQueensideRook =
+        ((playerInTurn == WHITE) ? board.HasWhiteMovedQueensideRook() :
+                                   board.HasBlackMovedQueensideRook());
+
+    const square_type rank = GET_RANK(m_kingSquare);
+    const square_type file = GET_FILE(m_kingSquare);
+
+    // The king may not pass over an attacked square. The square it ends on is
+    // verified along with every other king move.
+    if (!movedKingsideRook && board.IsEmpty(rank, file + 1) && board.IsEmpty(rank, file + 2) &&
+        !board.IsUnderAttack(rank, file + 1, !playerInTurn))
+    {
+        Move move(rank, file, rank, file + 2);
+        move.SetKingsideCastle();
+        move.SetMovingPiece(KING);
+
+        addMyMoveIfLegal(board, move);
+    }
+
+    if (!movedQueensideRook && board.IsEmpty(rank, file - 1) && board.IsEmpty(rank, file - 2) &&
+        !board.IsUnderAttack(rank, file - 1, !playerInTurn))
+    {
+        Move move(rank, file, rank, file - 2);
+        move.SetQueensideCastle();
+        move.SetMovingPiece(KING);
+
+        addMyMoveIfLegal(board, move);
+    }
+}
+
+//==================================================================================================
+void ValidMoveSet::generateValidMoves(const MoveSet &moveSet, BitBoard &board)
+{
+    color_type playerInTurn = board.GetPlayerInTurn();
 
     for (MoveList::size_type i = 0; i < BOARD_SIZE; ++i)
     {
-        MoveList wPawn = spMoveSet->GetWhitePawnMoves(i);
-        MoveList bPawn = spMoveSet->GetBlackPawnMoves(i);
-        MoveList knight = spMoveSet->GetKnightMoves(i);
-        MoveList king = spMoveSet->GetKingMoves(i);
+        std::span<const Move> wPawn = moveSet.GetWhitePawnMoves(i);
+        std::span<const Move> bPawn = moveSet.GetBlackPawnMoves(i);
+        std::span<const Move> knight = moveSet.GetKnightMoves(i);
+        std::span<const Move> king = moveSet.GetKingMoves(i);
 
         square_type rank = GET_RANK(i);
         square_type file = GET_FILE(i);
-        color_type c = spBoard->GetOccupant(rank, file);
+        color_type c = board.GetOccupant(rank, file);
 
         /***** EMPTY *****/
 
-        if (spBoard->IsEmpty(rank, file))
+        if (board.IsEmpty(rank, file))
         {
             continue;
         }
 
         /***** PAWN *****/
 
-        else if (spBoard->IsPawn(rank, file))
+        else if (board.IsPawn(rank, file))
         {
             // WHITE pawn
             if (c == WHITE)
             {
-                for (auto it = wPawn.begin(); it != wPawn.end(); ++it)
+                for (Move move : wPawn)
                 {
                     // Straight
-                    if (it->GetStartFile() == it->GetEndFile())
+                    if (move.GetStartFile() == move.GetEndFile())
                     {
                         // 2 move start
-                        if (it->GetEndRank() - it->GetStartRank() == 2)
+                        if (move.GetEndRank() - move.GetStartRank() == 2)
                         {
-                            if (spBoard->IsEmpty(it->GetStartRank() + 1, it->GetStartFile()))
+                            if (board.IsEmpty(move.GetStartRank() + 1, move.GetStartFile()))
                             {
-                                if (spBoard->IsEmpty(it->GetEndRank(), it->GetEndFile()))
+                                if (board.IsEmpty(move.GetEndRank(), move.GetEndFile()))
                                 {
-                                    it->SetMovingPiece(PAWN);
+                                    move.SetMovingPiece(PAWN);
 
                                     if (playerInTurn == WHITE)
                                     {
-                                        m_myValidMoves.push_back(*it);
+                                        addMyMoveIfLegal(board, move);
                                     }
                                     else
                                     {
-                                        m_oppValidMoves.push_back(*it);
+                                        m_oppValidMoves.push_back(move);
                                     }
                                 }
                             }
                         }
 
                         // Single move forward
-                        else if (spBoard->IsEmpty(it->GetEndRank(), it->GetEndFile()))
+                        else if (board.IsEmpty(move.GetEndRank(), move.GetEndFile()))
                         {
-                            it->SetMovingPiece(PAWN);
+                            move.SetMovingPiece(PAWN);
 
                             if (playerInTurn == WHITE)
                             {
-                                m_myValidMoves.push_back(*it);
+                                addMyMoveIfLegal(board, move);
                             }
                             else
                             {
-                                m_oppValidMoves.push_back(*it);
+                                m_oppValidMoves.push_back(move);
                             }
                         }
                     }
@@ -110,52 +414,41 @@ void ValidMoveSet::generateValidMoves(
                     // Attack diagonally
                     else
                     {
-                        if (playerInTurn == WHITE)
+                        if (board.IsBlack(move.GetEndRank(), move.GetEndFile()))
                         {
-                            m_defendValue[GET_SQUARE(it->GetEndRank(), it->GetEndFile())] +=
-                                s_pawnValue;
-                        }
-                        else
-                        {
-                            m_attackValue[GET_SQUARE(it->GetEndRank(), it->GetEndFile())] +=
-                                s_pawnValue;
-                        }
-
-                        if (spBoard->IsBlack(it->GetEndRank(), it->GetEndFile()))
-                        {
-                            it->SetCapture();
-                            it->SetMovingPiece(PAWN);
+                            move.SetCapture();
+                            move.SetMovingPiece(PAWN);
 
                             if (playerInTurn == WHITE)
                             {
-                                m_myValidMoves.push_back(*it);
+                                addMyMoveIfLegal(board, move);
                             }
                             else
                             {
-                                m_oppValidMoves.push_back(*it);
+                                m_oppValidMoves.push_back(move);
                             }
                         }
 
                         // En passant
-                        else if (spBoard->GetEnPassantColor() == BLACK)
+                        else if (board.GetEnPassantColor() == BLACK)
                         {
-                            square_type pos = spBoard->GetEnPassantPosition();
+                            square_type pos = board.GetEnPassantPosition();
                             square_type r = GET_RANK(pos);
                             square_type f = GET_FILE(pos);
 
-                            if ((r == it->GetEndRank()) && (f == it->GetEndFile()))
+                            if ((r == move.GetEndRank()) && (f == move.GetEndFile()))
                             {
-                                it->SetCapture();
-                                it->SetEnPassant();
-                                it->SetMovingPiece(PAWN);
+                                move.SetCapture();
+                                move.SetEnPassant();
+                                move.SetMovingPiece(PAWN);
 
                                 if (playerInTurn == WHITE)
                                 {
-                                    m_myValidMoves.push_back(*it);
+                                    addMyMoveIfLegal(board, move);
                                 }
                                 else
                                 {
-                                    m_oppValidMoves.push_back(*it);
+                                    m_oppValidMoves.push_back(move);
                                 }
                             }
                         }
@@ -166,44 +459,44 @@ void ValidMoveSet::generateValidMoves(
             // BLACK pawn
             else
             {
-                for (auto it = bPawn.begin(); it != bPawn.end(); ++it)
+                for (Move move : bPawn)
                 {
                     // Straight
-                    if (it->GetStartFile() == it->GetEndFile())
+                    if (move.GetStartFile() == move.GetEndFile())
                     {
                         // 2 move start
-                        if (it->GetStartRank() - it->GetEndRank() == 2)
+                        if (move.GetStartRank() - move.GetEndRank() == 2)
                         {
-                            if (spBoard->IsEmpty(it->GetStartRank() - 1, it->GetStartFile()))
+                            if (board.IsEmpty(move.GetStartRank() - 1, move.GetStartFile()))
                             {
-                                if (spBoard->IsEmpty(it->GetEndRank(), it->GetEndFile()))
+                                if (board.IsEmpty(move.GetEndRank(), move.GetEndFile()))
                                 {
-                                    it->SetMovingPiece(PAWN);
+                                    move.SetMovingPiece(PAWN);
 
                                     if (playerInTurn == BLACK)
                                     {
-                                        m_myValidMoves.push_back(*it);
+                                        addMyMoveIfLegal(board, move);
                                     }
                                     else
                                     {
-                                        m_oppValidMoves.push_back(*it);
+                                        m_oppValidMoves.push_back(move);
                                     }
                                 }
                             }
                         }
 
                         // Single move forward
-                        else if (spBoard->IsEmpty(it->GetEndRank(), it->GetEndFile()))
+                        else if (board.IsEmpty(move.GetEndRank(), move.GetEndFile()))
                         {
-                            it->SetMovingPiece(PAWN);
+                            move.SetMovingPiece(PAWN);
 
                             if (playerInTurn == BLACK)
                             {
-                                m_myValidMoves.push_back(*it);
+                                addMyMoveIfLegal(board, move);
                             }
                             else
                             {
-                                m_oppValidMoves.push_back(*it);
+                                m_oppValidMoves.push_back(move);
                             }
                         }
                     }
@@ -211,52 +504,41 @@ void ValidMoveSet::generateValidMoves(
                     // Attack diagonally
                     else
                     {
-                        if (playerInTurn == BLACK)
-                        {
-                            m_defendValue[GET_SQUARE(it->GetEndRank(), it->GetEndFile())] +=
-                                s_pawnValue;
-                        }
-                        else
-                        {
-                            m_attackValue[GET_SQUARE(it->GetEndRank(), it->GetEndFile())] +=
-                                s_pawnValue;
-                        }
-
-                        if (spBoard->IsWhite(it->GetEndRank(), it->GetEndFile()))
+                        if (board.IsWhite(move.GetEndRank(), move.GetEndFile()))
                         {
-                            it->SetCapture();
-                            it->SetMovingPiece(PAWN);
+                            move.SetCapture();
+                            move.SetMovingPiece(PAWN);
 
                             if (playerInTurn == BLACK)
                             {
-                                m_myValidMoves.push_back(*it);
+                                addMyMoveIfLegal(board, move);
                             }
                             else
                             {
-                                m_oppValidMoves.push_back(*it);
+                                m_oppValidMoves.push_back(move);
                             }
                         }
 
                         // En passant
-                        else if (spBoard->GetEnPassantColor() == WHITE)
+                        else if (board.GetEnPassantColor() == WHITE)
                         {
-                            square_type pos = spBoard->GetEnPassantPosition();
+                            square_type pos = board.GetEnPassantPosition();
                             square_type r = GET_RANK(pos);
                             square_type f = GET_FILE(pos);
 
-                            if ((r == it->GetEndRank()) && (f == it->GetEndFile()))
+                            if ((r == move.GetEndRank()) && (f == move.GetEndFile()))
                             {
-                                it->SetCapture();
-                                it->SetEnPassant();
-                                it->SetMovingPiece(PAWN);
+                                move.SetCapture();
+                                move.SetEnPassant();
+                                move.SetMovingPiece(PAWN);
 
                                 if (playerInTurn == BLACK)
                                 {
-                                    m_myValidMoves.push_back(*it);
+                                    addMyMoveIfLegal(board, move);
                                 }
                                 else
                                 {
-                                    m_oppValidMoves.push_back(*it);
+                                    m_oppValidMoves.push_back(move);
                                 }
                             }
                         }
@@ -267,51 +549,39 @@ void ValidMoveSet::generateValidMoves(
 
         /***** KNIGHT *****/
 
-        if (spBoard->IsKnight(rank, file))
+        if (board.IsKnight(rank, file))
         {
             if (playerInTurn == c)
             {
-                for (auto it = knight.begin(); it != knight.end(); ++it)
+                for (Move move : knight)
                 {
-                    square_type endSquare = GET_SQUARE(it->GetEndRank(), it->GetEndFile());
-
-                    if (spBoard->IsEmpty(it->GetEndRank(), it->GetEndFile()))
+                    if (board.IsEmpty(move.GetEndRank(), move.GetEndFile()))
                     {
-                        it->SetMovingPiece(KNIGHT);
-
-                        m_defendValue[endSquare] += s_knightValue;
-                        m_myValidMoves.push_back(*it);
+                        move.SetMovingPiece(KNIGHT);
+                        addMyMoveIfLegal(board, move);
                     }
-                    else if (c != spBoard->GetOccupant(it->GetEndRank(), it->GetEndFile()))
+                    else if (c != board.GetOccupant(move.GetEndRank(), move.GetEndFile()))
                     {
-                        it->SetMovingPiece(KNIGHT);
-                        it->SetCapture();
-
-                        m_defendValue[endSquare] += s_knightValue;
-                        m_myValidMoves.push_back(*it);
+                        move.SetMovingPiece(KNIGHT);
+                        move.SetCapture();
+                        addMyMoveIfLegal(board, move);
                     }
                 }
             }
             else
             {
-                for (auto it = knight.begin(); it != knight.end(); ++it)
+                for (Move move : knight)
                 {
-                    square_type endSquare = GET_SQUARE(it->GetEndRank(), it->GetEndFile());
-
-                    if (spBoard->IsEmpty(it->GetEndRank(), it->GetEndFile()))
+                    if (board.IsEmpty(move.GetEndRank(), move.GetEndFile()))
                     {
-                        it->SetMovingPiece(KNIGHT);
-
-                        m_attackValue[endSquare] += s_knightValue;
-                        m_oppValidMoves.push_back(*it);
+                        move.SetMovingPiece(KNIGHT);
+                        m_oppValidMoves.push_back(move);
                     }
-                    else if (c != spBoard->GetOccupant(it->GetEndRank(), it->GetEndFile()))
+                    else if (c != board.GetOccupant(move.GetEndRank(), move.GetEndFile()))
                     {
-                        it->SetMovingPiece(KNIGHT);
-                        it->SetCapture();
-
-                        m_attackValue[endSquare] += s_knightValue;
-                        m_oppValidMoves.push_back(*it);
+                        move.SetMovingPiece(KNIGHT);
+                        move.SetCapture();
+                        m_oppValidMoves.push_back(move);
                     }
                 }
             }
@@ -319,90 +589,70 @@ void ValidMoveSet::generateValidMoves(
 
         /***** BISHOP *****/
 
-        if (spBoard->IsBishop(rank, file))
+        if (board.IsBishop(rank, file))
         {
-            addSlidingMoveIfValid(
-                spBoard,
-                BISHOP,
-                c,
-                s_bishopValue,
-                spMoveSet->GetBishopMovesNE(i));
-            addSlidingMoveIfValid(
-                spBoard,
-                BISHOP,
-                c,
-                s_bishopValue,
-                spMoveSet->GetBishopMovesNW(i));
-            addSlidingMoveIfValid(
-                spBoard,
-                BISHOP,
-                c,
-                s_bishopValue,
-                spMoveSet->GetBishopMovesSE(i));
-            addSlidingMoveIfValid(
-                spBoard,
-                BISHOP,
-                c,
-                s_bishopValue,
-                spMoveSet->GetBishopMovesSW(i));
+            addSlidingMoveIfValid(board, BISHOP, c, moveSet.GetBishopMovesNE(i));
+            addSlidingMoveIfValid(board, BISHOP, c, moveSet.GetBishopMovesNW(i));
+            addSlidingMoveIfValid(board, BISHOP, c, moveSet.GetBishopMovesSE(i));
+            addSlidingMoveIfValid(board, BISHOP, c, moveSet.GetBishopMovesSW(i));
         }
 
         /***** ROOK *****/
 
-        else if (spBoard->IsRook(rank, file))
+        else if (board.IsRook(rank, file))
         {
-            addSlidingMoveIfValid(spBoard, ROOK, c, s_rookValue, spMoveSet->GetRookMovesN(i));
-            addSlidingMoveIfValid(spBoard, ROOK, c, s_rookValue, spMoveSet->GetRookMovesS(i));
-            addSlidingMoveIfValid(spBoard, ROOK, c, s_rookValue, spMoveSet->GetRookMovesE(i));
-            addSlidingMoveIfValid(spBoard, ROOK, c, s_rookValue, spMoveSet->GetRookMovesW(i));
+            addSlidingMoveIfValid(board, ROOK, c, moveSet.GetRookMovesN(i));
+            addSlidingMoveIfValid(board, ROOK, c, moveSet.GetRookMovesS(i));
+            addSlidingMoveIfValid(board, ROOK, c, moveSet.GetRookMovesE(i));
+            addSlidingMoveIfValid(board, ROOK, c, moveSet.GetRookMovesW(i));
         }
 
         /***** QUEEN *****/
 
-        else if (spBoard->IsQueen(rank, file))
+        else if (board.IsQueen(rank, file))
         {
-            addSlidingMoveIfValid(spBoard, QUEEN, c, s_queenValue, spMoveSet->GetQueenMovesN(i));
-            addSlidingMoveIfValid(spBoard, QUEEN, c, s_queenValue, spMoveSet->GetQueenMovesS(i));
-            addSlidingMoveIfValid(spBoard, QUEEN, c, s_queenValue, spMoveSet->GetQueenMovesE(i));
-            addSlidingMoveIfValid(spBoard, QUEEN, c, s_queenValue, spMoveSet->GetQueenMovesW(i));
-            addSlidingMoveIfValid(spBoard, QUEEN, c, s_queenValue, spMoveSet->GetQueenMovesNE(i));
-            addSlidingMoveIfValid(spBoard, QUEEN, c, s_queenValue, spMoveSet->GetQueenMovesNW(i));
-            addSlidingMoveIfValid(spBoard, QUEEN, c, s_queenValue, spMoveSet->GetQueenMovesSE(i));
-            addSlidingMoveIfValid(spBoard, QUEEN, c, s_queenValue, spMoveSet->GetQueenMovesSW(i));
+            addSlidingMoveIfValid(board, QUEEN, c, moveSet.GetQueenMovesN(i));
+            addSlidingMoveIfValid(board, QUEEN, c, moveSet.GetQueenMovesS(i));
+            addSlidingMoveIfValid(board, QUEEN, c, moveSet.GetQueenMovesE(i));
+            addSlidingMoveIfValid(board, QUEEN, c, moveSet.GetQueenMovesW(i));
+            addSlidingMoveIfValid(board, QUEEN, c, moveSet.GetQueenMovesNE(i));
+            addSlidingMoveIfValid(board, QUEEN, c, moveSet.GetQueenMovesNW(i));
+            addSlidingMoveIfValid(board, QUEEN, c, moveSet.GetQueenMovesSE(i));
+            addSlidingMoveIfValid(board, QUEEN, c, moveSet.GetQueenMovesSW(i));
         }
 
         /***** KING *****/
 
-        if (spBoard->IsKing(rank, file))
+        if (board.IsKing(rank, file))
         {
             color_type oppC = (c == WHITE ? BLACK : WHITE);
 
-            if (c == spBoard->GetPlayerInTurn())
+            if (c == board.GetPlayerInTurn())
             {
-                for (auto it = king.begin(); it != king.end(); ++it)
+                for (Move move : king)
                 {
                     bool movedKing =
-                        (c == WHITE ? spBoard->HasWhiteMovedKing() : spBoard->HasBlackMovedKing());
+                        (c == WHITE ? board.HasWhiteMovedKing() : board.HasBlackMovedKing());
                     bool movedKingsideRook =
-                        (c == WHITE ? spBoard->HasWhiteMovedKingsideRook() :
-                                      spBoard->HasBlackMovedKingsideRook());
+                        (c == WHITE ? board.HasWhiteMovedKingsideRook() :
+                                      board.HasBlackMovedKingsideRook());
                     bool movedQueensideRook =
-                        (c == WHITE ? spBoard->HasWhiteMovedQueensideRook() :
-                                      spBoard->HasBlackMovedQueensideRook());
+                        (c == WHITE ? board.HasWhiteMovedQueensideRook() :
+                                      board.HasBlackMovedQueensideRook());
                     bool inCheck =
-                        (c == WHITE ? spBoard->IsWhiteInCheck() : spBoard->IsBlackInCheck());
+                        (c == WHITE ? board.IsWhiteInCheck() : board.IsBlackInCheck());
 
-                    square_type diff = it->GetEndFile() - it->GetStartFile();
+                    square_type diff = move.GetEndFile() - move.GetStartFile();
 
                     // If the destination is empty
-                    if (spBoard->IsEmpty(it->GetEndRank(), it->GetEndFile()))
+                    if (board.IsEmpty(move.GetEndRank(), move.GetEndFile()))
                     {
                         // If the desitination is empty and we're not castling,
                         // definitely valid
                         if ((diff > -2) && (diff < 2))
                         {
-                            it->SetMovingPiece(KING);
-                            m_myValidMoves.push_back(*it);
+                            move.SetMovingPiece(KING);
+                            addMyMoveIfLegal(board, move);
                         }
 
                         // Verify castling move
@@ -412,16 +662,16 @@ void ValidMoveSet::generateValidMoves(
                             if (diff == 2)
                             {
                                 if (!movedKingsideRook &&
-                                    spBoard->IsEmpty(it->GetStartRank(), it->GetStartFile() + 1))
+                                    board.IsEmpty(move.GetStartRank(), move.GetStartFile() + 1))
                                 {
-                                    if (spBoard->IsUnderAttack(
-                                            it->GetStartRank(),
-                                            it->GetStartFile() + 1,
+                                    if (board.IsUnderAttack(
+                                            move.GetStartRank(),
+                                            move.GetStartFile() + 1,
                                             oppC) == 0)
                                     {
-                                        it->SetKingsideCastle();
-                                        it->SetMovingPiece(KING);
-                                        m_myValidMoves.push_back(*it);
+                                        move.SetKingsideCastle();
+                                        move.SetMovingPiece(KING);
+                                        addMyMoveIfLegal(board, move);
                                     }
                                 }
                             }
@@ -430,16 +680,16 @@ void ValidMoveSet::generateValidMoves(
                             else if (diff == -2)
                             {
                                 if (!movedQueensideRook &&
-                                    spBoard->IsEmpty(it->GetStartRank(), it->GetStartFile() - 1))
+                                    board.IsEmpty(move.GetStartRank(), move.GetStartFile() - 1))
                                 {
-                                    if (spBoard->IsUnderAttack(
-                                            it->GetStartRank(),
-                                            it->GetStartFile() - 1,
+                                    if (board.IsUnderAttack(
+                                            move.GetStartRank(),
+                                            move.GetStartFile() - 1,
                                             oppC) == 0)
                                     {
-                                        it->SetQueensideCastle();
-                                        it->SetMovingPiece(KING);
-                                        m_myValidMoves.push_back(*it);
+                                        move.SetQueensideCastle();
+                                        move.SetMovingPiece(KING);
+                                        addMyMoveIfLegal(board, move);
                                     }
                                 }
                             }
@@ -447,120 +697,139 @@ void ValidMoveSet::generateValidMoves(
                     }
 
                     // Or if we are white and destination is black
-                    else if ((c == WHITE) && spBoard->IsBlack(it->GetEndRank(), it->GetEndFile()))
+                    else if ((c == WHITE) && board.IsBlack(move.GetEndRank(), move.GetEndFile()))
                     {
                         if ((diff > -2) && (diff < 2))
                         {
-                            it->SetCapture();
-                            it->SetMovingPiece(KING);
-                            m_myValidMoves.push_back(*it);
+                            move.SetCapture();
+                            move.SetMovingPiece(KING);
+                            addMyMoveIfLegal(board, move);
                         }
                     }
 
                     // Or if we are black and destination is white
-                    else if ((c == BLACK) && spBoard->IsWhite(it->GetEndRank(), it->GetEndFile()))
+                    else if ((c == BLACK) && board.IsWhite(move.GetEndRank(), move.GetEndFile()))
                     {
                         if ((diff > -2) && (diff < 2))
                         {
-                            it->SetCapture();
-                            it->SetMovingPiece(KING);
-                            m_myValidMoves.push_back(*it);
+                            move.SetCapture();
+                            move.SetMovingPiece(KING);
+                            addMyMoveIfLegal(board, move);
                         }
                     }
                 }
             }
         }
     }
-
-    // Remove moves that leave player in check
-    MoveList newValidMoves;
-
-    for (auto it = m_myValidMoves.begin(); it != m_myValidMoves.end(); ++it)
-    {
-        BitBoard copy(*spBoard);
-        copy.MakeMove(*it);
-
-        // After making move, current player is opponent
-        if ((copy.GetPlayerInTurn() == WHITE) && copy.IsBlackInCheck())
-        {
-            // do nothing
-        }
-        else if ((copy.GetPlayerInTurn() == BLACK) && copy.IsWhiteInCheck())
-        {
-            // do nothing
-        }
-        else
-        {
-            newValidMoves.push_back(*it);
-        }
-    }
-
-    m_myValidMoves = newValidMoves;
 }
 
 //==================================================================================================
-MoveList ValidMoveSet::GetMyValidMoves() const
+const MoveList &ValidMoveSet::GetMyValidMoves() const
 {
     return m_myValidMoves;
 }
 
 //==================================================================================================
-MoveList ValidMoveSet::GetOppValidMoves() const
+const MoveList &ValidMoveSet::GetOppValidMoves() const
 {
     return m_oppValidMoves;
 }
 
 //==================================================================================================
-value_type ValidMoveSet::GetAttackValue(square_type rank, square_type file) const
+void ValidMoveSet::addMyMoveIfLegal(BitBoard &board, const Move &move)
 {
-    return m_attackValue[GET_SQUARE(rank, file)];
+    const square_type start = GET_SQUARE(move.GetStartRank(), move.GetStartFile());
+    const board_type endBit = 1_u64 << GET_SQUARE(move.GetEndRank(), move.GetEndFile());
+
+    bool legal = true;
+
+    if (move.GetMovingPiece() == KING)
+    {
+        legal = ((m_kingDangerSquares & endBit) == 0);
+    }
+    else if (move.IsEnPassant())
+    {
+        // Removing both pawns from their rank may expose the king to a slider,
+        // which the pin masks do not capture, so en passant is made to verify
+        Move enPassant = move;
+        board.MakeMove(enPassant);
+
+        // After making move, current player is opponent
+        legal =
+            ((board.GetPlayerInTurn() == WHITE) ? !board.IsBlackInCheck() :
+                                                  !board.IsWhiteInCheck());
+
+        board.UnmakeMove();
+    }
+    else if ((m_checkMask & endBit) == 0)
+    {
+        legal = false;
+    }
+    else if ((m_pinnedPieces >> start) & 0x1)
+    {
+        legal = ((Attacks::GetLine(m_kingSquare, start) & endBit) != 0);
+    }
+
+    if (legal)
+    {
+        m_myValidMoves.push_back(move);
+    }
 }
 
 //==================================================================================================
-value_type ValidMoveSet::GetDefendValue(square_type rank, square_type file) const
+void ValidMoveSet::addMyMovesIfLegal(
+    BitBoard &board,
+    const piece_type &piece,
+    const square_type &start,
+    board_type ends)
 {
-    return m_defendValue[GET_SQUARE(rank, file)];
+    const board_type opponent = board.GetColorPieces(!board.GetPlayerInTurn());
+
+    for (; ends != 0; ends &= ends - 1)
+    {
+        const square_type end = static_cast<square_type>(std::countr_zero(ends));
+
+        Move move(GET_RANK(start), GET_FILE(start), GET_RANK(end), GET_FILE(end));
+        move.SetMovingPiece(piece);
+
+        if ((opponent >> end) & 0x1)
+        {
+            move.SetCapture();
+        }
+
+        addMyMoveIfLegal(board, move);
+    }
 }
 
 //==================================================================================================
 void ValidMoveSet::addSlidingMoveIfValid(
-    const std::shared_ptr<BitBoard> &spBoard,
+    BitBoard &board,
     const piece_type &piece,
     const color_type &color,
-    const value_type &value,
-    MoveList moves)
+    std::span<const Move> moves)
 {
-    color_type playerInTurn = spBoard->GetPlayerInTurn();
+    color_type playerInTurn = board.GetPlayerInTurn();
 
     if (color == playerInTurn)
     {
-        for (auto it = moves.begin(); it != moves.end(); ++it)
+        for (Move move : moves)
         {
-            square_type endSquare = GET_SQUARE(it->GetEndRank(), it->GetEndFile());
-
             // If the square is empty, it's valid
-            if (spBoard->IsEmpty(it->GetEndRank(), it->GetEndFile()))
+            if (board.IsEmpty(move.GetEndRank(), move.GetEndFile()))
             {
-                it->SetMovingPiece(piece);
-
-                m_defendValue[endSquare] += value;
-                m_myValidMoves.push_back(*it);
+                move.SetMovingPiece(piece);
+                addMyMoveIfLegal(board, move);
 
                 continue;
             }
 
             // If the square is occupied by the opposing color, it's valid
-            else if (playerInTurn != spBoard->GetOccupant(it->GetEndRank(), it->GetEndFile()))
+            else if (playerInTurn != board.GetOccupant(move.GetEndRank(), move.GetEndFile()))
             {
-                it->SetCapture();
-                it->SetMovingPiece(piece);
-
-                m_myValidMoves.push_back(*it);
-            }
+                move.SetCapture();
+                move.SetMovingPiece(piece);
 
-            else
-            {
-                m_defendValue[endSquare] += value;
+                addMyMoveIfLegal(board, move);
             }
 
             break;
@@ -568,31 +837,22 @@ void ValidMoveSet::addSlidingMoveIfValid(
     }
     else
     {
-        for (auto it = moves.begin(); it != moves.end(); ++it)
+        for (Move move : moves)
         {
-            square_type endSquare = GET_SQUARE(it->GetEndRank(), it->GetEndFile());
-
-            if (spBoard->IsEmpty(it->GetEndRank(), it->GetEndFile()))
+            if (board.IsEmpty(move.GetEndRank(), move.GetEndFile()))
             {
-                it->SetMovingPiece(piece);
-
-                m_attackValue[endSquare] += value;
-                m_oppValidMoves.push_back(*it);
+                move.SetMovingPiece(piece);
+                m_oppValidMoves.push_back(move);
 
                 continue;
             }
 
-            else if (playerInTurn == spBoard->GetOccupant(it->GetEndRank(), it->GetEndFile()))
+            else if (playerInTurn == board.GetOccupant(move.GetEndRank(), move.GetEndFile()))
             {
-                it->SetCapture();
-                it->SetMovingPiece(piece);
-
-                m_oppValidMoves.push_back(*it);
-            }
+                move.SetCapture();
+                move.SetMovingPiece(piece);
 
-            else
-            {
-                m_attackValue[endSquare] += value;
+                m_oppValidMoves.push_back(move);
             }
 
             break;
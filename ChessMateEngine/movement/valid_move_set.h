@@ -2,9 +2,12 @@
 
 #include "game/bit_board.h"
 #include "movement/move.h"
+#include "movement/move_list.h"
 #include "movement/move_set.h"
+#include "movement/packed_move.h"
 
 #include <memory>
+#include <span>
 
 namespace chessmate {
 
@@ -13,6 +16,19 @@ namespace chessmate {
  * to generate a single list of actually possible moves given a board config.
  * Unlike the MoveSet file, this should be called after every move.
  *
+ * Only legal moves are generated for the turn player. The checking and pinned
+ * pieces are found once per position, and a move is legal if it captures or
+ * blocks the check, keeps a pinned piece on its pin line, or moves the king to
+ * a square the opponent does not attack.
+ *
+ * Besides every move of both players, the set may be generated with only the
+ * turn player's captures, only their quiet moves, or only their check evasions,
+ * so that a search may generate a node's moves in stages. A single move, such
+ * as one stored by an earlier search, may also be checked for legality by
+ * generating only the moving piece's moves. These are generated straight from
+ * the attack tables, without the precomputed move lists, the opponent's moves,
+ * or the attack and defense values.
+ *
  * @author Timothy Flynn (trflynn89@gmail.com)
  * @version March 3, 2013
  */
@@ -20,63 +36,170 @@ class ValidMoveSet
 {
 public:
     /**
-     * Default constructor.
+     * Default constructor. Creates an empty set without generating any moves.
+     */
+    ValidMoveSet();
+
+    /**
+     * Constructor to generate the valid moves of a board.
      *
      * @param std::shared_ptr<MoveSet> The list of possible moves.
      * @param std::shared_ptr<BitBoard> The board to generate moves for.
      */
     ValidMoveSet(const std::weak_ptr<MoveSet> &, const std::shared_ptr<BitBoard> &);
 
+    /**
+     * Generate the valid moves of a board, replacing any previously generated
+     * moves.
+     *
+     * @param MoveSet The list of possible moves.
+     * @param BitBoard The board to generate moves for.
+     */
+    void Generate(const MoveSet &, BitBoard &);
+
+    /**
+     * Generate only the turn player's legal captures, replacing any previously
+     * generated moves.
+     *
+     * @param BitBoard The board to generate moves for.
+     */
+    void GenerateCaptures(BitBoard &);
+
+    /**
+     * Generate only the turn player's legal moves which do not capture,
+     * including castling, replacing any previously generated moves.
+     *
+     * @param BitBoard The board to generate moves for.
+     */
+    void GenerateQuiets(BitBoard &);
+
+    /**
+     * Generate only the turn player's legal moves out of check, replacing any
+     * previously generated moves. The turn player must be in check.
+     *
+     * @param BitBoard The board to generate moves for.
+     */
+    void GenerateEvasions(BitBoard &);
+
+    /**
+     * Find a move among the turn player's legal moves, replacing any previously
+     * generated moves with those of the moving piece.
+     *
+     * @param BitBoard The board to generate moves for.
+     * @param PackedMove The move to find.
+     * @param Move The move to fill, if found.
+     *
+     * @return True if the move is legal.
+     */
+    bool FindLegalMove(BitBoard &, const PackedMove &, Move &);
+
+    /**
+     * Check if the turn player has any legal move, replacing any previously
+     * generated moves. Cheaper than generating every move, for detecting
+     * checkmate and stalemate.
+     *
+     * @param BitBoard The board to generate moves for.
+     *
+     * @return True if the turn player has a legal move.
+     */
+    bool HasLegalMoves(BitBoard &);
+
     /**
      * @return The list of the turn player's valid moves.
      */
-    MoveList GetMyValidMoves() const;
+    const MoveList &GetMyValidMoves() const;
 
     /**
      * @return The list of the opponent's valid moves.
      */
-    MoveList GetOppValidMoves() const;
+    const MoveList &GetOppValidMoves() const;
 
+private:
     /**
-     * @return A given square's attack value.
+     * Clear all generated moves.
      */
-    value_type GetAttackValue(square_type, square_type) const;
+    void reset();
 
     /**
-     * @return A given square's defense value.
+     * Find the turn player's king, the pieces pinned to it, the squares it may
+     * not move to, and the squares which resolve a check.
+     *
+     * @param BitBoard The board to generate moves for.
      */
-    value_type GetDefendValue(square_type, square_type) const;
+    void findMoveConstraints(const BitBoard &);
+
+    /**
+     * Generate the legal moves of the turn player's pieces on a set of squares
+     * which end on another set of squares, using the attack tables. En passant
+     * is generated if the pawn it captures is on a target square. Castling is
+     * not generated.
+     *
+     * @param BitBoard The board to generate moves for.
+     * @param board_type The squares of the pieces to move.
+     * @param board_type The squares pieces other than the king may move to.
+     * @param board_type The squares the king may move to.
+     */
+    void generateMovesTo(BitBoard &, board_type, board_type, board_type);
+
+    /**
+     * Generate the turn player's legal castling moves.
+     *
+     * @param BitBoard The board to generate moves for.
+     */
+    void generateCastlingMoves(BitBoard &);
+
+    /**
+     * Add a piece's moves to a set of squares to the turn player's list of
+     * moves, for each which does not leave their king in check.
+     *
+     * @param BitBoard The board to generate moves for.
+     * @param piece_type The moving piece.
+     * @param square_type The square the piece moves from.
+     * @param board_type The squares the piece moves to.
+     */
+    void addMyMovesIfLegal(BitBoard &, const piece_type &, const square_type &, board_type);
 
-private:
     /**
      * Generate a list of moves all pieces can make.
      *
-     * @param std::shared_ptr<MoveSet> The list of possible moves.
-     * @param std::shared_ptr<BitBoard> The board to generate moves for.
+     * @param MoveSet The list of possible moves.
+     * @param BitBoard The board to generate moves for.
+     */
+    void generateValidMoves(const MoveSet &, BitBoard &);
+
+    /**
+     * Add a move of the turn player to their list of moves, if it does not
+     * leave their king in check.
+     *
+     * @param BitBoard The board to generate moves for.
+     * @param Move The move to add.
      */
-    void generateValidMoves(const std::shared_ptr<MoveSet> &, const std::shared_ptr<BitBoard> &);
+    void addMyMoveIfLegal(BitBoard &, const Move &);
 
     /**
      * Given a list of sliding moves, add the move to the list if it is valid.
      *
-     * @param std::shared_ptr<BitBoard> The board to generate moves for.
+     * @param BitBoard The board to generate moves for.
      * @param piece_type The sliding piece.
      * @param color_type The sliding piece's color.
-     * @param value_type The sliding piece's value.
-     * @param MoveList The list of moves to check.
+     * @param span The list of moves to check.
      */
     void addSlidingMoveIfValid(
-        const std::shared_ptr<BitBoard> &,
+        BitBoard &,
         const piece_type &,
         const color_type &,
-        const value_type &,
-        MoveList);
+        std::span<const Move>);
 
     MoveList m_myValidMoves;
     MoveList m_oppValidMoves;
 
-    value_type m_attackValue[BOARD_SIZE];
-    value_type m_defendValue[BOARD_SIZE];
+    // Constraints on the turn player's moves: the location of their king, the
+    // pieces pinned to it, the squares it may not move to, and the squares
+    // which capture or block a check (every square if not in check)
+    square_type m_kingSquare;
+    board_type m_pinnedPieces;
+    board_type m_kingDangerSquares;
+    board_type m_checkMask;
 };
 
 } // namespace chessmate
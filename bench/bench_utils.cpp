@@ -0,0 +1,54 @@
+#include "bench_utils.h"
+
+#include "test/test_utils.h"
+
+#include <random>
+
+namespace chessmate::bench {
+
+namespace {
+
+    // Length of each random game, long enough to leave the opening behind
+    const std::size_t s_gameLength = 12;
+
+    // Seed of the random games
+    const std::mt19937::result_type s_seed = 1;
+
+} // namespace
+
+//==================================================================================================
+std::vector<std::shared_ptr<BitBoard>> MakePositions(const MoveSet &moveSet, std::size_t count)
+{
+    std::mt19937 random(s_seed);
+    std::vector<std::shared_ptr<BitBoard>> positions;
+
+    while (positions.size() < count)
+    {
+        auto spBoard = std::make_shared<BitBoard>();
+        std::size_t ply = 0;
+
+        while ((ply < s_gameLength) && test::MakeRandomMove(*spBoard, moveSet, random))
+        {
+            ++ply;
+        }
+
+        // A game which ended early has no moves left to search
+        if (ply == s_gameLength)
+        {
+            positions.push_back(std::move(spBoard));
+        }
+    }
+
+    return positions;
+}
+
+//==================================================================================================
+double ElapsedMilliseconds(const std::chrono::steady_clock::time_point &start)
+{
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    return elapsed.count();
+}
+
+} // namespace chessmate::bench
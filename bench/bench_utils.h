@@ -0,0 +1,31 @@
+#pragma once
+
+#include "game/bit_board.h"
+#include "movement/move_set.h"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace chessmate::bench {
+
+/**
+ * Create the positions to search, each reached by its own random game. The
+ * games are seeded, so every run searches the same positions.
+ *
+ * @param MoveSet The list of possible moves.
+ * @param size_t The number of positions to create.
+ *
+ * @return The positions.
+ */
+std::vector<std::shared_ptr<BitBoard>> MakePositions(const MoveSet &, std::size_t);
+
+/**
+ * @param steady_clock::time_point The time at which something started.
+ *
+ * @return The time elapsed since then, in milliseconds.
+ */
+double ElapsedMilliseconds(const std::chrono::steady_clock::time_point &);
+
+} // namespace chessmate::bench
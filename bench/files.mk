@@ -0,0 +1,14 @@
+SRC_DIRS_$(d) := \
+    $(SOURCE_ROOT)/ChessMateEngine/engine \
+    $(SOURCE_ROOT)/ChessMateEngine/game \
+    $(SOURCE_ROOT)/ChessMateEngine/movement
+
+SRC_$(d) := \
+    $(d)/main.cpp \
+    $(d)/bench_utils.cpp \
+    $(d)/negamax_benchmark.cpp \
+    $(d)/ybwc_benchmark.cpp \
+    $(SOURCE_ROOT)/test/minimax.cpp \
+    $(SOURCE_ROOT)/test/test_utils.cpp
+
+CXXFLAGS_$(d) += -I$(SOURCE_ROOT) -I$(SOURCE_ROOT)/ChessMateEngine
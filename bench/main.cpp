@@ -0,0 +1,32 @@
+#include "negamax_benchmark.h"
+#include "ybwc_benchmark.h"
+
+#include <array>
+#include <iostream>
+#include <string_view>
+#include <utility>
+
+namespace {
+
+    using Benchmark = void (*)();
+
+    // Every benchmark of the engine, by name
+    const std::array<std::pair<std::string_view, Benchmark>, 2> s_benchmarks = {{
+        {"NegamaxVersusMinimax", chessmate::bench::NegamaxVersusMinimax},
+        {"YoungBrothersWaitSpeedup", chessmate::bench::YoungBrothersWaitSpeedup},
+    }};
+
+} // namespace
+
+//==================================================================================================
+int main()
+{
+    for (const auto &[name, benchmark] : s_benchmarks)
+    {
+        std::cout << "Running " << name << std::endl;
+        benchmark();
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include "negamax_benchmark.h"
+
+#include "bench_utils.h"
+
+#include "test/minimax.h"
+
+#include "engine/move_selector.h"
+#include "engine/search_parameters.h"
+#include "engine/transposition_table.h"
+#include "game/bit_board.h"
+#include "movement/move_set.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+namespace chessmate::bench {
+
+namespace {
+
+    // Number of positions to search
+    const std::size_t s_positionCount = 4;
+
+    // Depths to search each position to
+    const value_type s_minDepth = 2;
+    const value_type s_maxDepth = 4;
+
+    // Size of the transposition table, in megabytes
+    const std::size_t s_transpositionTableSize = 16;
+
+    // Size of the evaluation cache, in megabytes
+    const std::size_t s_evaluationCacheSize = 1;
+
+} // namespace
+
+//==================================================================================================
+void NegamaxVersusMinimax()
+{
+    auto spMoveSet = std::make_shared<MoveSet>();
+    auto spSearchParameters = std::make_shared<SearchParameters>();
+
+    const auto positions = MakePositions(*spMoveSet, s_positionCount);
+
+    std::cout << std::setw(6) << "Depth" << std::setw(16) << "Minimax nodes" << std::setw(14)
+              << "Minimax ms" << std::setw(16) << "Negamax nodes" << std::setw(14)
+              << "Negamax ms" << std::setw(12) << "Ratio" << std::endl;
+
+    for (value_type depth = s_minDepth; depth <= s_maxDepth; ++depth)
+    {
+        std::uint64_t minimaxNodes = 0;
+        std::uint64_t negamaxNodes = 0;
+        double minimaxTime = 0.0;
+        double negamaxTime = 0.0;
+
+        for (const std::shared_ptr<BitBoard> &spBoard : positions)
+        {
+            const color_type engineColor = spBoard->GetPlayerInTurn();
+
+            MoveSelector moveSelector(
+                spMoveSet,
+                spBoard,
+                std::make_shared<TranspositionTable>(s_transpositionTableSize),
+                spSearchParameters,
+                s_evaluationCacheSize,
+                nullptr,
+                1,
+                MoveSelector::LAZY_SMP,
+                engineColor);
+
+            auto start = std::chrono::steady_clock::now();
+            moveSelector.GetBestMove(depth, std::chrono::milliseconds(0));
+            negamaxTime += ElapsedMilliseconds(start);
+            negamaxNodes += moveSelector.GetSearchStats().m_nodes.load();
+
+            BitBoard board(*spBoard);
+            test::Minimax minimax(*spMoveSet, engineColor);
+
+            start = std::chrono::steady_clock::now();
+            minimax.Search(board, depth);
+            minimaxTime += ElapsedMilliseconds(start);
+            minimaxNodes += minimax.GetNodeCount();
+        }
+
+        const double ratio = static_cast<double>(minimaxNodes) / static_cast<double>(negamaxNodes);
+
+        std::cout << std::fixed << std::setprecision(1) << std::setw(6) << depth << std::setw(16)
+                  << minimaxNodes << std::setw(14) << minimaxTime << std::setw(16) << negamaxNodes
+                  << std::setw(14) << negamaxTime << std::setw(11) << ratio << 'x' << std::endl;
+    }
+}
+
+} // namespace chessmate::bench
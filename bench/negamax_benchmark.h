@@ -0,0 +1,13 @@
+#pragma once
+
+namespace chessmate::bench {
+
+/**
+ * Search a set of positions to increasing depths, with an exhaustive search by
+ * the move selector and with a reference minimax search. Both find the same
+ * scores, so the difference in the number of nodes searched, and in the time
+ * taken, is entirely due to the move selector's alpha-beta cutoffs.
+ */
+void NegamaxVersusMinimax();
+
+} // namespace chessmate::bench
@@ -0,0 +1,122 @@
+#include "ybwc_benchmark.h"
+
+#include "bench_utils.h"
+
+#include "engine/move_selector.h"
+#include "engine/search_parameters.h"
+#include "engine/split_point.h"
+#include "engine/transposition_table.h"
+#include "game/bit_board.h"
+#include "game/game_config.h"
+#include "movement/move_set.h"
+
+#include <fly/task/task_manager.hpp>
+#include <fly/task/task_runner.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+namespace chessmate::bench {
+
+namespace {
+
+    // Number of positions to search
+    const std::size_t s_positionCount = 4;
+
+    // Depth to search each position to
+    const value_type s_depth = 9;
+
+    // Size of the transposition table, in megabytes
+    const std::size_t s_transpositionTableSize = 64;
+
+    /**
+     * Split point statistics, summed over every position's search.
+     */
+    struct SplitPointTotals
+    {
+        std::uint64_t m_splitPoints = 0;
+        std::uint64_t m_steals = 0;
+        std::uint64_t m_stolenMoves = 0;
+        std::uint64_t m_cutoffs = 0;
+    };
+
+} // namespace
+
+//==================================================================================================
+void YoungBrothersWaitSpeedup()
+{
+    const GameConfig config;
+
+    auto spMoveSet = std::make_shared<MoveSet>();
+    auto spSearchParameters = std::make_shared<SearchParameters>(
+        config.LateMoveReductionBase(),
+        config.LateMoveReductionDivisor(),
+        config.FutilityMargin(),
+        config.RazorMargin());
+
+    // Always compare against at least two threads, even on a single core
+    const unsigned int maxThreads = std::max(std::thread::hardware_concurrency(), 2U);
+
+    auto spTaskManager = fly::task::TaskManager::create(maxThreads);
+    auto spTaskRunner = fly::task::ParallelTaskRunner::create(spTaskManager);
+
+    const auto positions = MakePositions(*spMoveSet, s_positionCount);
+    double singleThreadTime = 0.0;
+
+    std::cout << std::setw(8) << "Threads" << std::setw(12) << "Time ms" << std::setw(10)
+              << "Speedup" << std::setw(14) << "Split points" << std::setw(10) << "Steals"
+              << std::setw(14) << "Stolen moves" << std::setw(10) << "Cutoffs" << std::endl;
+
+    for (unsigned int threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        SplitPointTotals totals;
+        double time = 0.0;
+
+        for (const std::shared_ptr<BitBoard> &spBoard : positions)
+        {
+            // Each search starts from an empty transposition table, so that no
+            // number of threads benefits from an earlier search
+            MoveSelector moveSelector(
+                spMoveSet,
+                spBoard,
+                std::make_shared<TranspositionTable>(s_transpositionTableSize),
+                spSearchParameters,
+                config.EvaluationCacheSize(),
+                spTaskRunner,
+                threads,
+                MoveSelector::YOUNG_BROTHERS_WAIT,
+                spBoard->GetPlayerInTurn());
+
+            const auto start = std::chrono::steady_clock::now();
+            moveSelector.GetBestMove(s_depth, std::chrono::milliseconds(0));
+            time += ElapsedMilliseconds(start);
+
+            const SplitPointStats &stats = moveSelector.GetSplitPointStats();
+            totals.m_splitPoints += stats.m_splitPoints.load();
+            totals.m_steals += stats.m_steals.load();
+            totals.m_stolenMoves += stats.m_stolenMoves.load();
+            totals.m_cutoffs += stats.m_cutoffs.load();
+        }
+
+        if (threads == 1)
+        {
+            singleThreadTime = time;
+        }
+
+        std::cout << std::fixed << std::setprecision(1) << std::setw(8) << threads
+                  << std::setw(12) << time << std::setw(9) << (singleThreadTime / time) << 'x'
+                  << std::setw(14) << totals.m_splitPoints << std::setw(10) << totals.m_steals
+                  << std::setw(14) << totals.m_stolenMoves << std::setw(10) << totals.m_cutoffs
+                  << std::endl;
+    }
+
+    spTaskManager->stop();
+}
+
+} // namespace chessmate::bench
@@ -0,0 +1,13 @@
+#pragma once
+
+namespace chessmate::bench {
+
+/**
+ * Search a set of positions to a fixed depth with a single thread, and then
+ * with the Young Brothers Wait Concept on increasing numbers of threads. The
+ * time taken by each number of threads is compared to a single thread's, and
+ * the split points created and stolen along the way are counted.
+ */
+void YoungBrothersWaitSpeedup();
+
+} // namespace chessmate::bench
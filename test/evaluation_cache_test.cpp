@@ -0,0 +1,187 @@
+#include "evaluation_cache_test.h"
+
+#include "test_utils.h"
+
+#include "engine/evaluation_cache.h"
+#include "engine/evaluator.h"
+#include "engine/pawn_hash_table.h"
+#include "game/bit_board.h"
+#include "movement/move_set.h"
+#include "movement/valid_move_set.h"
+
+#include <cstddef>
+#include <random>
+
+namespace chessmate::test {
+
+namespace {
+
+    // Number and length of the random games to score
+    const std::size_t s_gameCount = 200;
+    const std::size_t s_gameLength = 120;
+
+    // Number of entries in the pawn hash table used to score positions
+    const std::size_t s_pawnHashTableSize = 1 << 10;
+
+    /**
+     * Play 1. e4 e5 2. Ke2 Ke7 3. Ke1 Ke8, which returns the kings to their
+     * squares without any castling rights.
+     */
+    bool playKingWalk(BitBoard &board, const MoveSet &moveSet)
+    {
+        return MakeMove(board, moveSet, RANK_2, FILE_E, RANK_4, FILE_E) &&
+            MakeMove(board, moveSet, RANK_7, FILE_E, RANK_5, FILE_E) &&
+            MakeMove(board, moveSet, RANK_1, FILE_E, RANK_2, FILE_E) &&
+            MakeMove(board, moveSet, RANK_8, FILE_E, RANK_7, FILE_E) &&
+            MakeMove(board, moveSet, RANK_2, FILE_E, RANK_1, FILE_E) &&
+            MakeMove(board, moveSet, RANK_7, FILE_E, RANK_8, FILE_E);
+    }
+
+    /**
+     * Move white's queen out and back, while black's knight does the same.
+     */
+    bool playQueenWalk(BitBoard &board, const MoveSet &moveSet)
+    {
+        return MakeMove(board, moveSet, RANK_1, FILE_D, RANK_2, FILE_E) &&
+            MakeMove(board, moveSet, RANK_8, FILE_G, RANK_6, FILE_F) &&
+            MakeMove(board, moveSet, RANK_2, FILE_E, RANK_1, FILE_D) &&
+            MakeMove(board, moveSet, RANK_6, FILE_F, RANK_8, FILE_G);
+    }
+
+    /**
+     * Move white's kingside rook out and back, while both players' knights do
+     * the same.
+     */
+    bool playRookWalk(BitBoard &board, const MoveSet &moveSet)
+    {
+        return MakeMove(board, moveSet, RANK_1, FILE_G, RANK_3, FILE_F) &&
+            MakeMove(board, moveSet, RANK_8, FILE_G, RANK_6, FILE_F) &&
+            MakeMove(board, moveSet, RANK_1, FILE_H, RANK_1, FILE_G) &&
+            MakeMove(board, moveSet, RANK_6, FILE_F, RANK_8, FILE_G) &&
+            MakeMove(board, moveSet, RANK_1, FILE_G, RANK_1, FILE_H) &&
+            MakeMove(board, moveSet, RANK_8, FILE_G, RANK_6, FILE_F) &&
+            MakeMove(board, moveSet, RANK_3, FILE_F, RANK_1, FILE_G) &&
+            MakeMove(board, moveSet, RANK_6, FILE_F, RANK_8, FILE_G);
+    }
+
+    /**
+     * Score a position directly, the same way the search does.
+     */
+    int scorePosition(BitBoard &board, const Evaluator &evaluator, PawnHashTable &pawnHashTable)
+    {
+        ValidMoveSet validMoves;
+        return evaluator.Score(board, validMoves.HasLegalMoves(board), pawnHashTable);
+    }
+
+    /**
+     * Score a position directly, and compare the score with the position's
+     * cached score if there is one. Otherwise, cache the score.
+     */
+    bool checkCachedScore(
+        BitBoard &board,
+        const Evaluator &evaluator,
+        PawnHashTable &pawnHashTable,
+        EvaluationCache &cache,
+        std::size_t &hits)
+    {
+        // Positions drawn by their history are never cached by the search
+        if (board.IsStalemateViaFiftyMoves() || board.IsStalemateViaRepetition())
+        {
+            return true;
+        }
+
+        const hash_type key = EvaluationCache::GetKey(board);
+        const int score = scorePosition(board, evaluator, pawnHashTable);
+        int cached = 0;
+
+        if (cache.Probe(key, cached))
+        {
+            ++hits;
+            return Expect(cached == score, "cached score matches the evaluator's score");
+        }
+
+        cache.Store(key, score);
+        return true;
+    }
+
+} // namespace
+
+//==================================================================================================
+bool EvaluationCacheKeyCoversMovedPieces()
+{
+    const MoveSet moveSet;
+    const Evaluator evaluator(WHITE);
+    PawnHashTable pawnHashTable(s_pawnHashTableSize);
+
+    BitBoard kingWalk;
+    bool passed = Expect(playKingWalk(kingWalk, moveSet), "played the king walk");
+
+    BitBoard queenWalk(kingWalk);
+    passed &= Expect(playQueenWalk(queenWalk, moveSet), "played the queen walk");
+
+    BitBoard rookWalk(kingWalk);
+    passed &= Expect(playRookWalk(rookWalk, moveSet), "played the rook walk");
+
+    for (BitBoard *pBoard : {&queenWalk, &rookWalk})
+    {
+        BitBoard &board = *pBoard;
+
+        passed &= Expect(
+            board.GetHashKey() == kingWalk.GetHashKey(),
+            "positions share a hash key");
+        passed &= Expect(
+            EvaluationCache::GetKey(board) != EvaluationCache::GetKey(kingWalk),
+            "positions do not share a cache key");
+        passed &= Expect(
+            scorePosition(board, evaluator, pawnHashTable) !=
+                scorePosition(kingWalk, evaluator, pawnHashTable),
+            "positions are scored differently");
+    }
+
+    return passed;
+}
+
+//==================================================================================================
+bool EvaluationCacheMatchesEvaluator()
+{
+    const MoveSet moveSet;
+    const Evaluator evaluator(WHITE);
+    PawnHashTable pawnHashTable(s_pawnHashTableSize);
+    EvaluationCache cache(1);
+
+    std::mt19937 random(89);
+    std::size_t hits = 0;
+    bool passed = true;
+
+    for (std::size_t game = 0; game < s_gameCount; ++game)
+    {
+        BitBoard board;
+
+        for (std::size_t ply = 0; ply < s_gameLength; ++ply)
+        {
+            passed &= checkCachedScore(board, evaluator, pawnHashTable, cache, hits);
+
+            if (!MakeRandomMove(board, moveSet, random))
+            {
+                break;
+            }
+        }
+    }
+
+    // Positions which share a hash key, but not the pieces which have moved
+    BitBoard kingWalk;
+    passed &= Expect(playKingWalk(kingWalk, moveSet), "played the king walk");
+    passed &= checkCachedScore(kingWalk, evaluator, pawnHashTable, cache, hits);
+
+    BitBoard queenWalk(kingWalk);
+    passed &= Expect(playQueenWalk(queenWalk, moveSet), "played the queen walk");
+    passed &= checkCachedScore(queenWalk, evaluator, pawnHashTable, cache, hits);
+
+    BitBoard rookWalk(kingWalk);
+    passed &= Expect(playRookWalk(rookWalk, moveSet), "played the rook walk");
+    passed &= checkCachedScore(rookWalk, evaluator, pawnHashTable, cache, hits);
+
+    return passed && Expect(hits > 0, "some positions were found in the cache");
+}
+
+} // namespace chessmate::test
@@ -0,0 +1,25 @@
+#pragma once
+
+namespace chessmate::test {
+
+/**
+ * Reach the same placement of pieces, with the same castling rights, through
+ * two histories in which different pieces have moved. The positions share a
+ * Zobrist hash key, but are scored differently, so must not share a key in the
+ * evaluation cache.
+ *
+ * @return True if the test passed.
+ */
+bool EvaluationCacheKeyCoversMovedPieces();
+
+/**
+ * Score every position of a number of random games, along with positions which
+ * are reached through different histories, both directly and through an
+ * evaluation cache. Every score found in the cache must match the position's
+ * directly computed score.
+ *
+ * @return True if the test passed.
+ */
+bool EvaluationCacheMatchesEvaluator();
+
+} // namespace chessmate::test
@@ -0,0 +1,105 @@
+#include "evaluator_test.h"
+
+#include "test_utils.h"
+
+#include "engine/evaluator.h"
+#include "engine/pawn_hash_table.h"
+#include "game/bit_board.h"
+#include "movement/move_set.h"
+#include "movement/valid_move_set.h"
+
+#include <cstddef>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace chessmate::test {
+
+namespace {
+
+    // Number of threads scoring positions at once
+    const std::size_t s_threadCount = 8;
+
+    // Number of times each thread scores every position
+    const std::size_t s_passCount = 4;
+
+    // Number and length of the random games to score
+    const std::size_t s_gameCount = 50;
+    const std::size_t s_gameLength = 120;
+
+    // Seed of the random games, so that every thread plays the same games
+    const std::mt19937::result_type s_seed = 21;
+
+    // Number of entries in each thread's pawn hash table
+    const std::size_t s_pawnHashTableSize = 1 << 10;
+
+    /**
+     * Play the random games, scoring every position along the way. Boards are
+     * not shared between threads, so each thread replays the games itself.
+     */
+    std::vector<int> scoreGames(const MoveSet &moveSet, const Evaluator &evaluator)
+    {
+        PawnHashTable pawnHashTable(s_pawnHashTableSize);
+        ValidMoveSet validMoves;
+
+        std::mt19937 random(s_seed);
+        std::vector<int> scores;
+
+        for (std::size_t game = 0; game < s_gameCount; ++game)
+        {
+            BitBoard board;
+
+            for (std::size_t ply = 0; ply < s_gameLength; ++ply)
+            {
+                scores.push_back(
+                    evaluator.Score(board, validMoves.HasLegalMoves(board), pawnHashTable));
+
+                if (!MakeRandomMove(board, moveSet, random))
+                {
+                    break;
+                }
+            }
+        }
+
+        return scores;
+    }
+
+} // namespace
+
+//==================================================================================================
+bool EvaluatorIsThreadSafe()
+{
+    const MoveSet moveSet;
+    const Evaluator evaluator(WHITE);
+
+    const std::vector<int> expected = scoreGames(moveSet, evaluator);
+
+    std::vector<std::vector<int>> results(s_threadCount * s_passCount);
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < s_threadCount; ++i)
+    {
+        threads.emplace_back([&moveSet, &evaluator, &results, i]() {
+            for (std::size_t pass = 0; pass < s_passCount; ++pass)
+            {
+                results[(i * s_passCount) + pass] = scoreGames(moveSet, evaluator);
+            }
+        });
+    }
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    bool passed = Expect(!expected.empty(), "positions were scored");
+
+    for (const std::vector<int> &scores : results)
+    {
+        passed &= Expect(scores == expected, "scores match a single thread's scores");
+    }
+
+    return passed;
+}
+
+} // namespace chessmate::test
@@ -0,0 +1,14 @@
+#pragma once
+
+namespace chessmate::test {
+
+/**
+ * Score the positions of a number of random games on many threads at once,
+ * with a single evaluator shared by every thread. Each thread must find the
+ * same scores as a single thread scoring the positions alone.
+ *
+ * @return True if the test passed.
+ */
+bool EvaluatorIsThreadSafe();
+
+} // namespace chessmate::test
@@ -0,0 +1,15 @@
+SRC_DIRS_$(d) := \
+    $(SOURCE_ROOT)/ChessMateEngine/engine \
+    $(SOURCE_ROOT)/ChessMateEngine/game \
+    $(SOURCE_ROOT)/ChessMateEngine/movement
+
+SRC_$(d) := \
+    $(d)/main.cpp \
+    $(d)/test_utils.cpp \
+    $(d)/evaluation_cache_test.cpp \
+    $(d)/evaluator_test.cpp \
+    $(d)/minimax.cpp \
+    $(d)/move_picker_test.cpp \
+    $(d)/move_selector_test.cpp
+
+CXXFLAGS_$(d) += -I$(SOURCE_ROOT)/ChessMateEngine
@@ -0,0 +1,47 @@
+#include "evaluation_cache_test.h"
+#include "evaluator_test.h"
+#include "move_picker_test.h"
+#include "move_selector_test.h"
+
+#include <array>
+#include <iostream>
+#include <string_view>
+#include <utility>
+
+namespace {
+
+    using Test = bool (*)();
+
+    // Every test of the engine, by name
+    const std::array<std::pair<std::string_view, Test>, 5> s_tests = {{
+        {"EvaluationCacheKeyCoversMovedPieces",
+         chessmate::test::EvaluationCacheKeyCoversMovedPieces},
+        {"EvaluationCacheMatchesEvaluator", chessmate::test::EvaluationCacheMatchesEvaluator},
+        {"EvaluatorIsThreadSafe", chessmate::test::EvaluatorIsThreadSafe},
+        {"MovePickerPicksEveryMove", chessmate::test::MovePickerPicksEveryMove},
+        {"NegamaxMatchesMinimax", chessmate::test::NegamaxMatchesMinimax},
+    }};
+
+} // namespace
+
+//==================================================================================================
+int main()
+{
+    int failures = 0;
+
+    for (const auto &[name, test] : s_tests)
+    {
+        std::cout << "Running " << name << std::endl;
+
+        if (!test())
+        {
+            std::cout << "FAILED " << name << std::endl;
+            ++failures;
+        }
+    }
+
+    std::cout << (s_tests.size() - failures) << " of " << s_tests.size() << " tests passed"
+              << std::endl;
+
+    return (failures == 0) ? 0 : 1;
+}
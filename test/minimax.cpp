@@ -0,0 +1,103 @@
+#include "minimax.h"
+
+#include "movement/move.h"
+#include "movement/valid_move_set.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace chessmate::test {
+
+namespace {
+
+    const value_type s_negInfinity = -32767;
+
+    // Number of entries in the pawn hash table
+    const std::size_t s_pawnHashTableSize = 1 << 14;
+
+} // namespace
+
+//==================================================================================================
+Minimax::Minimax(const MoveSet &moveSet, const color_type &engineColor) :
+    m_moveSet(moveSet),
+    m_engineColor(engineColor),
+    m_evaluator(engineColor),
+    m_pawnHashTable(s_pawnHashTableSize),
+    m_nodeCount(0)
+{
+}
+
+//==================================================================================================
+value_type Minimax::Search(BitBoard &board, const value_type &depth)
+{
+    m_nodeCount = 0;
+
+    ValidMoveSet validMoves;
+    validMoves.Generate(m_moveSet, board);
+
+    value_type v = s_negInfinity;
+
+    // As in the move selector, the root's moves are searched to the full depth,
+    // rather than one less
+    for (Move move : validMoves.GetMyValidMoves())
+    {
+        board.MakeMove(move);
+        v = std::max<value_type>(v, -minimax(board, depth));
+        board.UnmakeMove();
+    }
+
+    return v;
+}
+
+//==================================================================================================
+std::uint64_t Minimax::GetNodeCount() const
+{
+    return m_nodeCount;
+}
+
+//==================================================================================================
+value_type Minimax::minimax(BitBoard &board, const value_type &depth)
+{
+    ++m_nodeCount;
+
+    ValidMoveSet validMoves;
+
+    if (board.IsRepeatedPosition())
+    {
+        return 0;
+    }
+    else if (depth <= 1)
+    {
+        return evaluate(board, validMoves.HasLegalMoves(board));
+    }
+
+    validMoves.Generate(m_moveSet, board);
+
+    const MoveList &moves = validMoves.GetMyValidMoves();
+
+    // As in the move selector, a node is not searched once the game is over
+    if (moves.empty() || board.IsStalemateViaFiftyMoves() || board.IsStalemateViaRepetition())
+    {
+        return evaluate(board, !moves.empty());
+    }
+
+    value_type v = s_negInfinity;
+
+    for (Move move : moves)
+    {
+        board.MakeMove(move);
+        v = std::max<value_type>(v, -minimax(board, depth - 1));
+        board.UnmakeMove();
+    }
+
+    return v;
+}
+
+//==================================================================================================
+value_type Minimax::evaluate(BitBoard &board, bool hasLegalMoves)
+{
+    const int score = m_evaluator.Score(board, hasLegalMoves, m_pawnHashTable);
+    return static_cast<value_type>((board.GetPlayerInTurn() == m_engineColor) ? score : -score);
+}
+
+} // namespace chessmate::test
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "engine/evaluator.h"
+#include "engine/pawn_hash_table.h"
+#include "game/bit_board.h"
+#include "game/board_types.h"
+#include "movement/move_set.h"
+
+#include <cstdint>
+
+namespace chessmate::test {
+
+/**
+ * A reference search, which scores a position by plain minimax: every move is
+ * searched to the full depth, and no node is cut off. Nodes are scored exactly
+ * as an exhaustive search by the move selector scores them, down to scoring
+ * repeated positions as draws, so the two searches must find the same score.
+ * Only the number of nodes searched may differ.
+ *
+ * @author Timothy Flynn (trflynn89@gmail.com)
+ * @version October 17, 2026
+ */
+class Minimax
+{
+public:
+    /**
+     * Constructor.
+     *
+     * @param MoveSet The list of possible moves.
+     * @param color_type The engine color.
+     */
+    Minimax(const MoveSet &, const color_type &);
+
+    /**
+     * Score the best move of a position, searching each move to a depth.
+     *
+     * @param BitBoard The board to search.
+     * @param value_type The depth to search.
+     *
+     * @return The score of the best move, from the engine's perspective.
+     */
+    value_type Search(BitBoard &, const value_type &);
+
+    /**
+     * @return The number of nodes searched by the most recent search.
+     */
+    std::uint64_t GetNodeCount() const;
+
+private:
+    /**
+     * Search a node to a depth.
+     *
+     * @param BitBoard The board to search.
+     * @param value_type The depth to search.
+     *
+     * @return The score of the node, from the perspective of the player in turn.
+     */
+    value_type minimax(BitBoard &, const value_type &);
+
+    /**
+     * Score a node statically.
+     *
+     * @param BitBoard The board to score.
+     * @param bool True if the player in turn has any legal moves.
+     *
+     * @return The score of the node, from the perspective of the player in turn.
+     */
+    value_type evaluate(BitBoard &, bool);
+
+    const MoveSet &m_moveSet;
+    color_type m_engineColor;
+
+    Evaluator m_evaluator;
+    PawnHashTable m_pawnHashTable;
+
+    std::uint64_t m_nodeCount;
+};
+
+} // namespace chessmate::test
@@ -0,0 +1,126 @@
+#include "move_picker_test.h"
+
+#include "test_utils.h"
+
+#include "engine/move_history.h"
+#include "engine/move_picker.h"
+#include "game/bit_board.h"
+#include "movement/move.h"
+#include "movement/move_list.h"
+#include "movement/move_set.h"
+#include "movement/packed_move.h"
+#include "movement/valid_move_set.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace chessmate::test {
+
+namespace {
+
+    // Number of random games to play, and the most plies played in each
+    const std::size_t s_gameCount = 20;
+    const std::size_t s_plyCount = 80;
+
+    // Seed of the random games
+    const std::mt19937::result_type s_seed = 13;
+
+    /**
+     * Collect the packed form of a list of moves, in sorted order.
+     *
+     * @param MoveList The moves to collect.
+     *
+     * @return The sorted packed moves.
+     */
+    std::vector<std::uint16_t> sortedMoves(const MoveList &moves)
+    {
+        std::vector<std::uint16_t> sorted;
+
+        for (const Move &move : moves)
+        {
+            sorted.push_back(PackedMove(move).GetData());
+        }
+
+        std::sort(sorted.begin(), sorted.end());
+        return sorted;
+    }
+
+} // namespace
+
+//==================================================================================================
+bool MovePickerPicksEveryMove()
+{
+    MoveSet moveSet;
+    MoveHistory history;
+
+    std::mt19937 random(s_seed);
+    std::size_t capturesChecked = 0;
+    bool passed = true;
+
+    for (std::size_t game = 0; game < s_gameCount; ++game)
+    {
+        BitBoard board;
+
+        for (std::size_t ply = 0; ply < s_plyCount; ++ply)
+        {
+            ValidMoveSet validMoves;
+            validMoves.Generate(moveSet, board);
+
+            const std::vector<std::uint16_t> expected = sortedMoves(validMoves.GetMyValidMoves());
+            std::vector<PackedMove> captures;
+
+            for (const Move &move : validMoves.GetMyValidMoves())
+            {
+                if (move.IsCapture())
+                {
+                    captures.push_back(PackedMove(move));
+                }
+            }
+
+            // A killer move or countermove is only ever a quiet move when it is
+            // stored, but may match a capture's squares in a later position
+            for (const PackedMove &capture : captures)
+            {
+                const std::array<std::array<PackedMove, 2>, 2> killers = {{
+                    {capture, PackedMove()},
+                    {PackedMove(), PackedMove()},
+                }};
+                const std::array<PackedMove, 2> counterMoves = {PackedMove(), capture};
+
+                for (std::size_t i = 0; i < counterMoves.size(); ++i)
+                {
+                    MoveList collected;
+                    MoveList picked;
+
+                    MovePicker picker(
+                        board,
+                        validMoves,
+                        collected,
+                        PackedMove(),
+                        killers[i],
+                        counterMoves[i],
+                        history);
+                    picker.TakeRemaining(picked);
+
+                    passed &= Expect(sortedMoves(picked) == expected, "every move is picked once");
+                }
+
+                ++capturesChecked;
+            }
+
+            if (!MakeRandomMove(board, moveSet, random))
+            {
+                break;
+            }
+        }
+    }
+
+    passed &= Expect(capturesChecked > 0, "captures were checked");
+    return passed;
+}
+
+} // namespace chessmate::test
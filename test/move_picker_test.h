@@ -0,0 +1,15 @@
+#pragma once
+
+namespace chessmate::test {
+
+/**
+ * Pick the moves of the positions of a number of random games, with each of a
+ * position's captures in turn given as a killer move and as the countermove.
+ * The picker must pick the same moves as are generated at once, each exactly
+ * once.
+ *
+ * @return True if the test passed.
+ */
+bool MovePickerPicksEveryMove();
+
+} // namespace chessmate::test
@@ -0,0 +1,90 @@
+#include "move_selector_test.h"
+
+#include "minimax.h"
+#include "test_utils.h"
+
+#include "engine/move_selector.h"
+#include "engine/search_parameters.h"
+#include "engine/transposition_table.h"
+#include "game/bit_board.h"
+#include "movement/move_set.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+
+namespace chessmate::test {
+
+namespace {
+
+    // Number of random games to search, and the plies played between searches
+    const std::size_t s_gameCount = 4;
+    const std::size_t s_searchCount = 3;
+    const std::size_t s_pliesPerSearch = 6;
+
+    // Depth of each search
+    const value_type s_depth = 3;
+
+    // Seed of the random games
+    const std::mt19937::result_type s_seed = 20;
+
+    // Size of the transposition table, in megabytes
+    const std::size_t s_transpositionTableSize = 4;
+
+    // Size of the evaluation cache, in megabytes
+    const std::size_t s_evaluationCacheSize = 1;
+
+} // namespace
+
+//==================================================================================================
+bool NegamaxMatchesMinimax()
+{
+    auto spMoveSet = std::make_shared<MoveSet>();
+    auto spSearchParameters = std::make_shared<SearchParameters>();
+
+    std::mt19937 random(s_seed);
+    bool passed = true;
+
+    for (std::size_t game = 0; game < s_gameCount; ++game)
+    {
+        auto spBoard = std::make_shared<BitBoard>();
+
+        for (std::size_t search = 0; search < s_searchCount; ++search)
+        {
+            for (std::size_t ply = 0; ply < s_pliesPerSearch; ++ply)
+            {
+                passed &= Expect(MakeRandomMove(*spBoard, *spMoveSet, random), "game continues");
+            }
+
+            const color_type engineColor = spBoard->GetPlayerInTurn();
+
+            MoveSelector moveSelector(
+                spMoveSet,
+                spBoard,
+                std::make_shared<TranspositionTable>(s_transpositionTableSize),
+                spSearchParameters,
+                s_evaluationCacheSize,
+                nullptr,
+                1,
+                MoveSelector::LAZY_SMP,
+                engineColor);
+            moveSelector.GetBestMove(s_depth, std::chrono::milliseconds(0));
+
+            BitBoard board(*spBoard);
+            Minimax minimax(*spMoveSet, engineColor);
+            const value_type score = minimax.Search(board, s_depth);
+
+            const std::uint64_t negamaxNodes = moveSelector.GetSearchStats().m_nodes.load();
+            const std::uint64_t minimaxNodes = minimax.GetNodeCount();
+
+            passed &= Expect(moveSelector.GetBestScore() == score, "scores match minimax");
+            passed &= Expect(negamaxNodes < minimaxNodes, "fewer nodes than minimax");
+        }
+    }
+
+    return passed;
+}
+
+} // namespace chessmate::test
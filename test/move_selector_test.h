@@ -0,0 +1,14 @@
+#pragma once
+
+namespace chessmate::test {
+
+/**
+ * Search the positions of a number of random games with an exhaustive search
+ * by the move selector, and with a reference minimax search. The move selector
+ * must find the same score as minimax, while searching fewer nodes.
+ *
+ * @return True if the test passed.
+ */
+bool NegamaxMatchesMinimax();
+
+} // namespace chessmate::test
@@ -0,0 +1,66 @@
+#include "test_utils.h"
+
+#include "movement/move.h"
+#include "movement/valid_move_set.h"
+
+#include <iostream>
+
+namespace chessmate::test {
+
+//==================================================================================================
+bool Expect(bool condition, std::string_view description)
+{
+    if (!condition)
+    {
+        std::cerr << "    Failed: " << description << std::endl;
+    }
+
+    return condition;
+}
+
+//==================================================================================================
+bool MakeMove(
+    BitBoard &board,
+    const MoveSet &moveSet,
+    const square_type &sRank,
+    const square_type &sFile,
+    const square_type &eRank,
+    const square_type &eFile)
+{
+    ValidMoveSet validMoves;
+    validMoves.Generate(moveSet, board);
+
+    for (Move move : validMoves.GetMyValidMoves())
+    {
+        if ((move.GetStartRank() == sRank) && (move.GetStartFile() == sFile) &&
+            (move.GetEndRank() == eRank) && (move.GetEndFile() == eFile))
+        {
+            board.MakeMove(move);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//==================================================================================================
+bool MakeRandomMove(BitBoard &board, const MoveSet &moveSet, std::mt19937 &random)
+{
+    ValidMoveSet validMoves;
+    validMoves.Generate(moveSet, board);
+
+    const MoveList &moves = validMoves.GetMyValidMoves();
+
+    if (moves.empty())
+    {
+        return false;
+    }
+
+    std::uniform_int_distribution<MoveList::size_type> distribution(0, moves.size() - 1);
+    Move move = moves[distribution(random)];
+
+    board.MakeMove(move);
+    return true;
+}
+
+} // namespace chessmate::test
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "game/bit_board.h"
+#include "game/board_types.h"
+#include "movement/move_set.h"
+
+#include <random>
+#include <string_view>
+
+namespace chessmate::test {
+
+/**
+ * Check a condition of a test, reporting it if it does not hold.
+ *
+ * @param bool The condition to check.
+ * @param string_view A description of the condition.
+ *
+ * @return The condition.
+ */
+bool Expect(bool, std::string_view);
+
+/**
+ * Make a legal move on a board, as it would be found by generating the board's
+ * valid moves.
+ *
+ * @param BitBoard The board to make the move on.
+ * @param MoveSet The list of possible moves.
+ * @param square_type The rank of the square to move from.
+ * @param square_type The file of the square to move from.
+ * @param square_type The rank of the square to move to.
+ * @param square_type The file of the square to move to.
+ *
+ * @return True if the move was legal, and was made.
+ */
+bool MakeMove(
+    BitBoard &,
+    const MoveSet &,
+    const square_type &,
+    const square_type &,
+    const square_type &,
+    const square_type &);
+
+/**
+ * Make a random legal move on a board.
+ *
+ * @param BitBoard The board to make the move on.
+ * @param MoveSet The list of possible moves.
+ * @param mt19937 The random number generator to pick the move with.
+ *
+ * @return True if a move was made, false if the player in turn has no moves.
+ */
+bool MakeRandomMove(BitBoard &, const MoveSet &, std::mt19937 &);
+
+} // namespace chessmate::test